@@ -0,0 +1,163 @@
+//
+// Copyright 2018 The Simons Foundation, Inc. - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "bench.h"
+#include <fstream>
+#include <iostream>
+#include <sys/resource.h>
+
+using namespace itensor;
+using std::string;
+
+namespace itensor {
+
+//Reset the peak resident memory of the process,
+//returns false if the OS does not support it
+bool
+resetPeakMemory()
+    {
+    auto f = std::ofstream("/proc/self/clear_refs");
+    if(not f) return false;
+    f << "5";
+    return bool(f);
+    }
+
+//Peak resident memory in MB
+Real
+peakMemoryMB()
+    {
+    auto f = std::ifstream("/proc/self/status");
+    auto line = string();
+    while(std::getline(f,line))
+        {
+        if(line.compare(0,6,"VmHWM:") == 0)
+            {
+            return std::stod(line.substr(6))/1024.;
+            }
+        }
+    struct rusage u;
+    getrusage(RUSAGE_SELF,&u);
+#ifdef __APPLE__
+    return u.ru_maxrss/(1024.*1024.);
+#else
+    return u.ru_maxrss/1024.;
+#endif
+    }
+
+BenchRunner::
+BenchRunner(Args const& args)
+    {
+    filter_ = args.getString("Filter","");
+    quick_ = args.getBool("Quick",false);
+    min_time_ = args.getReal("MinTime",1.);
+    }
+
+void BenchRunner::
+run(string const& name,
+    Real flops,
+    std::function<void()> const& f,
+    int maxreps)
+    {
+    if(not filter_.empty() && name.find(filter_) == string::npos) return;
+
+    using clock = std::chrono::steady_clock;
+    resetPeakMemory();
+    auto r = BenchResult();
+    r.name = name;
+    r.seconds = -1;
+    auto total = 0.;
+    while(r.reps < maxreps && (r.reps == 0 || total < min_time_))
+        {
+        auto start = clock::now();
+        f();
+        auto t = std::chrono::duration<Real>(clock::now()-start).count();
+        if(r.seconds < 0 || t < r.seconds) r.seconds = t;
+        total += t;
+        ++r.reps;
+        }
+    r.peak_mb = peakMemoryMB();
+    if(flops > 0 && r.seconds > 0) r.gflops = flops/r.seconds/1E9;
+
+    std::cerr << format("%-36s %10.4f s %9.2f GFLOP/s %9.1f MB (%d reps)\n",
+                        name,r.seconds,r.gflops,r.peak_mb,r.reps);
+    results_.push_back(std::move(r));
+    }
+
+void BenchRunner::
+writeJSON(std::ostream & s) const
+    {
+    //One result per line, as expected by the compare tool
+    s << "{\n";
+    s << "\"quick\": " << (quick_ ? "true" : "false") << ",\n";
+    s << "\"results\": [\n";
+    for(auto n : range(results_.size()))
+        {
+        auto& r = results_[n];
+        s << format("{\"name\": \"%s\", \"reps\": %d, \"seconds\": %.6e, \"gflops\": %.4f, \"peak_mb\": %.2f}",
+                    r.name,r.reps,r.seconds,r.gflops,r.peak_mb);
+        s << (n+1 < results_.size() ? ",\n" : "\n");
+        }
+    s << "]\n}\n";
+    }
+
+} //namespace itensor
+
+int
+main(int argc, char* argv[])
+    {
+    auto args = Args("Quick=",false);
+    auto outfile = string();
+    for(int n = 1; n < argc; ++n)
+        {
+        auto a = string(argv[n]);
+        if(a == "-quick")
+            {
+            args.add("Quick",true);
+            }
+        else if(a == "-filter" && n+1 < argc)
+            {
+            args.add("Filter",string(argv[++n]));
+            }
+        else if(a == "-mintime" && n+1 < argc)
+            {
+            args.add("MinTime",std::stod(argv[++n]));
+            }
+        else if(a == "-o" && n+1 < argc)
+            {
+            outfile = argv[++n];
+            }
+        else
+            {
+            printfln("Usage: %s [-quick] [-filter <name>] [-mintime <sec>] [-o <file.json>]",argv[0]);
+            return 1;
+            }
+        }
+
+    seedRNG(1);
+    auto B = BenchRunner(args);
+    microBenchmarks(B);
+    macroBenchmarks(B);
+
+    if(outfile.empty())
+        {
+        B.writeJSON(std::cout);
+        }
+    else
+        {
+        auto f = std::ofstream(outfile);
+        B.writeJSON(f);
+        }
+    return 0;
+    }
@@ -0,0 +1,83 @@
+//
+// Copyright 2018 The Simons Foundation, Inc. - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef __ITENSOR_BENCH_H
+#define __ITENSOR_BENCH_H
+
+#include "itensor/all.h"
+#include <chrono>
+#include <functional>
+
+namespace itensor {
+
+struct BenchResult
+    {
+    std::string name;
+    int reps = 0;
+    //Fastest of the reps, in seconds
+    Real seconds = 0.;
+    //Zero if the flop count of the benchmark is unknown
+    Real gflops = 0.;
+    //Peak resident memory during the benchmark, in MB
+    Real peak_mb = 0.;
+    };
+
+class BenchRunner
+    {
+    std::string filter_;
+    bool quick_ = false;
+    Real min_time_ = 1.;
+    std::vector<BenchResult> results_;
+    public:
+
+    //
+    // Named arguments recognized:
+    //  "Filter" - only run benchmarks whose name contains this string
+    //  "Quick"  - if true, benchmarks use smaller problem sizes
+    //  "MinTime" - repeat a benchmark until this many seconds
+    //              have been spent on it (default 1)
+    //
+    BenchRunner(Args const& args = Args::global());
+
+    bool
+    quick() const { return quick_; }
+
+    //
+    // Time f, which does flops floating-point operations
+    // per call (0 if unknown). Calls f at most maxreps times
+    // and reports the fastest call.
+    //
+    void
+    run(std::string const& name,
+        Real flops,
+        std::function<void()> const& f,
+        int maxreps = 20);
+
+    std::vector<BenchResult> const&
+    results() const { return results_; }
+
+    void
+    writeJSON(std::ostream & s) const;
+    };
+
+void
+microBenchmarks(BenchRunner & B);
+
+void
+macroBenchmarks(BenchRunner & B);
+
+} //namespace itensor
+
+#endif
@@ -0,0 +1,123 @@
+//
+// Copyright 2018 The Simons Foundation, Inc. - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+// Compare two result files written by the bench program:
+//
+//   ./compare_results base.json new.json [tolerance]
+//
+// A benchmark is flagged as a regression if its time
+// or peak memory grew by more than the tolerance
+// (default 0.1, i.e. 10%). Exits with status 1 if
+// there was any regression.
+//
+#include "itensor/util/print.h"
+#include <fstream>
+#include <map>
+
+using namespace itensor;
+using std::string;
+
+struct Entry
+    {
+    double seconds = 0.;
+    double peak_mb = 0.;
+    };
+
+//Value of "key" in a line of the form {"key": value, ...}
+string
+field(string const& line, string const& key)
+    {
+    auto k = "\"" + key + "\":";
+    auto p = line.find(k);
+    if(p == string::npos) return "";
+    p += k.size();
+    while(p < line.size() && line[p] == ' ') ++p;
+    if(p < line.size() && line[p] == '"')
+        {
+        auto e = line.find('"',p+1);
+        return line.substr(p+1,e-p-1);
+        }
+    auto e = line.find_first_of(",}",p);
+    return line.substr(p,e-p);
+    }
+
+std::map<string,Entry>
+readResults(string const& fname)
+    {
+    auto f = std::ifstream(fname);
+    if(not f)
+        {
+        printfln("Could not open file %s",fname);
+        std::exit(2);
+        }
+    auto res = std::map<string,Entry>{};
+    auto line = string();
+    while(std::getline(f,line))
+        {
+        auto name = field(line,"name");
+        if(name.empty()) continue;
+        auto& e = res[name];
+        e.seconds = std::stod(field(line,"seconds"));
+        e.peak_mb = std::stod(field(line,"peak_mb"));
+        }
+    return res;
+    }
+
+int
+main(int argc, char* argv[])
+    {
+    if(argc < 3)
+        {
+        printfln("Usage: %s base.json new.json [tolerance]",argv[0]);
+        return 2;
+        }
+    auto base = readResults(argv[1]);
+    auto next = readResults(argv[2]);
+    auto tol = (argc > 3) ? std::stod(argv[3]) : 0.1;
+
+    printfln("%-36s %11s %11s %7s %9s %9s",
+             "benchmark","base (s)","new (s)","ratio","base MB","new MB");
+    auto nregress = 0;
+    for(auto& b : base)
+        {
+        auto it = next.find(b.first);
+        if(it == next.end())
+            {
+            printfln("%-36s missing from %s",b.first,argv[2]);
+            continue;
+            }
+        auto& o = b.second;
+        auto& n = it->second;
+        auto ratio = n.seconds/o.seconds;
+        auto flag = string();
+        if(ratio > 1+tol) flag += " SLOWER";
+        if(n.peak_mb > (1+tol)*o.peak_mb) flag += " MORE MEMORY";
+        if(not flag.empty()) ++nregress;
+        printfln("%-36s %11.4f %11.4f %7.3f %9.1f %9.1f%s",
+                 b.first,o.seconds,n.seconds,ratio,o.peak_mb,n.peak_mb,flag);
+        }
+    for(auto& n : next)
+        {
+        if(base.count(n.first) == 0) printfln("%-36s new benchmark",n.first);
+        }
+
+    if(nregress > 0)
+        {
+        printfln("\n%d regression(s) beyond tolerance %.2f",nregress,tol);
+        return 1;
+        }
+    return 0;
+    }
@@ -0,0 +1,147 @@
+//
+// Copyright 2018 The Simons Foundation, Inc. - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "bench.h"
+
+namespace itensor {
+
+//Ground state of the spin 1 Heisenberg chain,
+//as in sample/dmrg.cc
+void
+heisenbergDMRG(BenchRunner & B)
+    {
+    auto N = B.quick() ? 20 : 100;
+    auto sites = SpinOne(N);
+    auto ampo = AutoMPO(sites);
+    for(auto j : range1(N-1))
+        {
+        ampo += 0.5,"S+",j,"S-",j+1;
+        ampo += 0.5,"S-",j,"S+",j+1;
+        ampo +=     "Sz",j,"Sz",j+1;
+        }
+    auto H = toMPO(ampo);
+    auto state = InitState(sites);
+    for(auto j : range1(N)) state.set(j,j%2==1 ? "Up" : "Dn");
+
+    auto sweeps = Sweeps(5);
+    sweeps.maxdim() = 10,20,100,100,200;
+    sweeps.cutoff() = 1E-10;
+    sweeps.niter() = 2;
+    sweeps.noise() = 1E-7,1E-8,0.0;
+    if(B.quick()) sweeps.maxdim() = 10,20,50;
+
+    B.run("dmrg/heisenberg_spin1",0,[&]
+        {
+        auto [energy,psi] = dmrg(H,MPS(state),sweeps,{"Silent=",true});
+        },1);
+    }
+
+//Ground state of the Hubbard chain at half filling,
+//as in sample/exthubbard.cc
+void
+hubbardDMRG(BenchRunner & B)
+    {
+    auto N = B.quick() ? 10 : 32;
+    auto U = 4.;
+    auto sites = Electron(N);
+    auto ampo = AutoMPO(sites);
+    for(auto i : range1(N)) ampo += U,"Nupdn",i;
+    for(auto b : range1(N-1))
+        {
+        ampo += -1,"Cdagup",b,"Cup",b+1;
+        ampo += -1,"Cdagup",b+1,"Cup",b;
+        ampo += -1,"Cdagdn",b,"Cdn",b+1;
+        ampo += -1,"Cdagdn",b+1,"Cdn",b;
+        }
+    auto H = toMPO(ampo);
+    auto state = InitState(sites);
+    for(auto i : range1(N)) state.set(i,i%2==1 ? "Up" : "Dn");
+
+    auto sweeps = Sweeps(5);
+    sweeps.maxdim() = 50,100,200,400,400;
+    sweeps.cutoff() = 1E-10;
+    sweeps.noise() = 1E-6,1E-7,1E-8,0.0;
+    if(B.quick()) sweeps.maxdim() = 20,50,100;
+
+    B.run("dmrg/hubbard",0,[&]
+        {
+        auto [energy,psi] = dmrg(H,MPS(state),sweeps,{"Silent=",true});
+        },1);
+    }
+
+//Real-time evolution of the Neel state of the
+//spin 1/2 Heisenberg chain with Trotter gates
+void
+heisenbergTEBD(BenchRunner & B)
+    {
+    auto N = B.quick() ? 16 : 50;
+    auto tstep = 0.05;
+    auto ttotal = B.quick() ? 0.2 : 1.;
+    auto sites = SpinHalf(N);
+    auto gates = std::vector<BondGate>{};
+    auto bondH = [&sites](int b)
+        {
+        auto hh = op(sites,"Sz",b)*op(sites,"Sz",b+1);
+        hh += 0.5*op(sites,"S+",b)*op(sites,"S-",b+1);
+        hh += 0.5*op(sites,"S-",b)*op(sites,"S+",b+1);
+        return hh;
+        };
+    for(auto b : range1(N-1)) gates.emplace_back(sites,b,b+1,BondGate::tReal,tstep/2.,bondH(b));
+    for(auto b = N-1; b >= 1; --b) gates.emplace_back(sites,b,b+1,BondGate::tReal,tstep/2.,bondH(b));
+
+    auto state = InitState(sites);
+    for(auto j : range1(N)) state.set(j,j%2==1 ? "Up" : "Dn");
+
+    B.run("tebd/heisenberg",0,[&]
+        {
+        auto psi = MPS(state);
+        gateTEvol(gates,ttotal,tstep,psi,{"Cutoff=",1E-8,"MaxDim=",100,"ShowPercent=",false});
+        },1);
+    }
+
+//Apply the Heisenberg MPO to a random MPS
+void
+applyMPOBench(BenchRunner & B)
+    {
+    auto N = B.quick() ? 20 : 50;
+    auto m = B.quick() ? 20 : 50;
+    auto sites = SpinHalf(N,{"ConserveQNs=",false});
+    auto ampo = AutoMPO(sites);
+    for(auto j : range1(N-1))
+        {
+        ampo += 0.5,"S+",j,"S-",j+1;
+        ampo += 0.5,"S-",j,"S+",j+1;
+        ampo +=     "Sz",j,"Sz",j+1;
+        }
+    auto H = toMPO(ampo);
+    auto psi = randomMPS(sites,m);
+
+    for(auto method : {"DensityMatrix","ZipUp","Fit"})
+        {
+        auto args = Args("Method=",method,"Cutoff=",1E-10,"MaxDim=",4*m);
+        B.run(format("applyMPO/%s",method),0,[&]{ auto Hpsi = applyMPO(H,psi,args); },3);
+        }
+    }
+
+void
+macroBenchmarks(BenchRunner & B)
+    {
+    heisenbergDMRG(B);
+    hubbardDMRG(B);
+    heisenbergTEBD(B);
+    applyMPOBench(B);
+    }
+
+} //namespace itensor
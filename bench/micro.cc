@@ -0,0 +1,118 @@
+//
+// Copyright 2018 The Simons Foundation, Inc. - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "bench.h"
+
+namespace itensor {
+
+Real
+totalDim(IndexSet const& is)
+    {
+    auto d = 1.;
+    for(auto& i : is) d *= dim(i);
+    return d;
+    }
+
+//Number of floating-point operations to contract
+//two dense real tensors
+Real
+contractFlops(ITensor const& A, ITensor const& B)
+    {
+    return 2.*totalDim(inds(A))*totalDim(inds(B))/totalDim(commonInds(A,B));
+    }
+
+AutoMPO
+heisenbergAutoMPO(SiteSet const& sites, int range = 1)
+    {
+    auto N = length(sites);
+    auto ampo = AutoMPO(sites);
+    for(auto i : range1(N))
+    for(auto j : range1(i+1,std::min(N,i+range)))
+        {
+        auto J = 1./((j-i)*(j-i));
+        ampo += 0.5*J,"S+",i,"S-",j;
+        ampo += 0.5*J,"S-",i,"S+",j;
+        ampo +=     J,"Sz",i,"Sz",j;
+        }
+    return ampo;
+    }
+
+void
+microBenchmarks(BenchRunner & B)
+    {
+    //
+    // Take the tensors from a DMRG calculation so
+    // the benchmarks use typical MPS/MPO shapes
+    //
+    auto N = 20;
+    auto m = B.quick() ? 50 : 200;
+    auto sites = SpinHalf(N,{"ConserveQNs=",true});
+    auto H = toMPO(heisenbergAutoMPO(sites));
+    auto state = InitState(sites);
+    for(auto j : range1(N)) state.set(j,j%2==1 ? "Up" : "Dn");
+    auto sweeps = Sweeps(4);
+    sweeps.maxdim() = 20,m/2,m;
+    sweeps.cutoff() = 1E-14;
+    auto [energy,psi] = dmrg(H,MPS(state),sweeps,{"Silent=",true});
+    (void)energy;
+
+    auto c = N/2;
+    psi.position(c);
+    auto L = ITensor(1.);
+    for(auto n : range1(c-1)) L = L*psi(n)*H(n)*dag(prime(psi(n)));
+
+    auto LA = L*psi(c);
+    auto LAW = LA*H(c);
+    auto Apd = dag(prime(psi(c)));
+    auto R = ITensor();
+
+    B.run("contract/qn_env_mps",0,[&]{ R = L*psi(c); });
+    B.run("contract/qn_env_mpo",0,[&]{ R = LA*H(c); });
+    B.run("contract/qn_env_close",0,[&]{ R = LAW*Apd; });
+
+    auto dL = removeQNs(L),
+         dA = removeQNs(psi(c)),
+         dLA = removeQNs(LA),
+         dW = removeQNs(H(c)),
+         dLAW = removeQNs(LAW),
+         dApd = removeQNs(Apd);
+    B.run("contract/env_mps",contractFlops(dL,dA),[&]{ R = dL*dA; });
+    B.run("contract/env_mpo",contractFlops(dLA,dW),[&]{ R = dLA*dW; });
+    B.run("contract/env_close",contractFlops(dLAW,dApd),[&]{ R = dLAW*dApd; });
+
+    //Two-site wavefunction
+    auto phi = psi(c)*psi(c+1);
+    auto dphi = removeQNs(phi);
+    auto rev = std::vector<Index>{};
+    for(auto& i : inds(dphi)) rev.insert(rev.begin(),i);
+    B.run("permute/two_site",0,[&]{ R = permute(dphi,IndexSet(rev)); });
+
+    auto uinds = uniqueInds(psi(c),psi(c+1));
+    auto svdargs = Args("MaxDim=",m,"Cutoff=",1E-12);
+    B.run("svd/qn_two_site",0,[&]{ auto [U,S,V] = svd(phi,uinds,svdargs); });
+    auto duinds = std::vector<Index>{};
+    for(auto& i : uinds) duinds.push_back(removeQNs(i));
+    B.run("svd/two_site",0,[&]{ auto [U,S,V] = svd(dphi,IndexSet(duinds),svdargs); });
+
+    auto rho = phi*dag(prime(phi,uinds));
+    B.run("eig/qn_density_matrix",0,[&]{ auto [U,D] = diagHermitian(rho,svdargs); });
+
+    auto Na = B.quick() ? 20 : 50;
+    auto asites = SpinHalf(Na,{"ConserveQNs=",true});
+    auto ampo = heisenbergAutoMPO(asites,Na);
+    B.run("autompo/long_range",0,[&]{ auto W = toMPO(ampo); },3);
+    }
+
+} //namespace itensor
@@ -35,11 +35,13 @@
 #include "itensor/util/stats.h"
 
 #include "itensor/mps/dmrg.h"
+#include "itensor/mps/dmrgscan.h"
 #include "itensor/mps/tevol.h"
 #include "itensor/mps/autompo.h"
 
 #include "itensor/mps/lattice/square.h"
 #include "itensor/mps/lattice/triangular.h"
+#include "itensor/mps/lattice/ordering.h"
 
 #include "itensor/mps/sites/spinhalf.h"
 #include "itensor/mps/sites/spinone.h"
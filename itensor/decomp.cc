@@ -125,32 +125,6 @@ svd(ITensor const& AA,
     ITensor & V,
     Args args)
     {
-    if( args.defined("Minm") )
-      {
-      if( args.defined("MinDim") )
-        {
-        Global::warnDeprecated("Args Minm and MinDim are both defined. Minm is deprecated in favor of MinDim, MinDim will be used.");
-        }
-      else
-        {
-        Global::warnDeprecated("Arg Minm is deprecated in favor of MinDim.");
-        args.add("MinDim",args.getInt("Minm"));
-        }
-      }
-
-    if( args.defined("Maxm") )
-      {
-      if( args.defined("MaxDim") )
-        {
-        Global::warnDeprecated("Args Maxm and MaxDim are both defined. Maxm is deprecated in favor of MaxDim, MaxDim will be used.");
-        }
-      else
-        {
-        Global::warnDeprecated("Arg Maxm is deprecated in favor of MaxDim.");
-        args.add("MaxDim",args.getInt("Maxm"));
-        }
-      }
-
     if( args.defined("UseOrigM") )
       {
       if( args.defined("UseOrigDim") )
@@ -164,13 +138,26 @@ svd(ITensor const& AA,
         }
       }
 
+    //The deprecated names Minm and Maxm are handled
+    //by TruncateOptions
+    return svd(AA,U,D,V,TruncateOptions(args,svdTruncateDefaults()),args);
+    }
+
+Spectrum
+svd(ITensor const& AA,
+    ITensor & U,
+    ITensor & D,
+    ITensor & V,
+    TruncateOptions opts,
+    Args const& args)
+    {
 #ifdef DEBUG
     if(!U && !V)
         Error("U and V default-initialized in svd, must indicate at least one index on U or V");
 #endif
 
     auto noise = args.getReal("Noise",0);
-    auto useOrigDim = args.getBool("UseOrigDim",false);
+    auto useOrigDim = args.getBool("UseOrigDim",args.getBool("UseOrigM",false));
 
     if(noise > 0)
         Error("Noise term not implemented for svd");
@@ -217,7 +204,8 @@ svd(ITensor const& AA,
         {
         //Try to determine current m,
         //then set mindim_ and maxdim_ to this.
-        args.add("Cutoff",-1);
+        opts.truncate = args.getBool("Truncate",true);
+        opts.cutoff = -1;
         long mindim = 1,
              maxdim = MAX_DIM;
         if(D.order() == 0)
@@ -232,14 +220,14 @@ svd(ITensor const& AA,
             {
             mindim = maxdim = dim(D.inds().front());
             }
-        args.add("MinDim",mindim);
-        args.add("MaxDim",maxdim);
+        opts.mindim = mindim;
+        opts.maxdim = maxdim;
         }
 
     //auto ui = commonIndex(AAcomb,Ucomb);
     //auto vi = commonIndex(AAcomb,Vcomb);
 
-    auto spec = svdOrd2(AAcomb,ui,vi,U,D,V,args);
+    auto spec = svdOrd2(AAcomb,ui,vi,U,D,V,opts,args);
 
     U = dag(Ucomb) * U;
     V = V * dag(Vcomb);
@@ -302,7 +290,59 @@ polar(ITensor const& T,
     return std::tuple<ITensor,ITensor>(Q,P);
     }
 
-// output: truncerr,docut_lower,docut_upper,ndegen_below
+namespace {
+
+//Read an integer arg, falling back to its deprecated name
+void
+readDeprecatedInt(Args const& args,
+                  Args::Key const& name,
+                  Args::Key const& oldname,
+                  long & val)
+    {
+    if(args.defined(oldname))
+        {
+        if(args.defined(name))
+            {
+            Global::warnDeprecated(format("Args %s and %s are both defined. %s is deprecated in favor of %s, %s will be used.",
+                                          oldname.str(),name.str(),oldname.str(),name.str(),name.str()));
+            }
+        else
+            {
+            Global::warnDeprecated(format("Arg %s is deprecated in favor of %s.",oldname.str(),name.str()));
+            val = args.getInt(oldname);
+            }
+        }
+    val = args.getInt(name,val);
+    }
+
+} //namespace
+
+TruncateOptions::
+TruncateOptions(Args const& args,
+                TruncateOptions const& defaults)
+  : TruncateOptions(defaults)
+    {
+    readDeprecatedInt(args,"MinDim","Minm",mindim);
+    readDeprecatedInt(args,"MaxDim","Maxm",maxdim);
+    auto def_truncate = args.defined("Cutoff") || args.defined("MaxDim") 
+                     || args.defined("Maxm") || defaults.truncate;
+    truncate = args.getBool("Truncate",def_truncate);
+    cutoff = args.getReal("Cutoff",cutoff);
+    doRelCutoff = args.getBool("DoRelCutoff",doRelCutoff);
+    absoluteCutoff = args.getBool("AbsoluteCutoff",absoluteCutoff);
+    respectDegenerate = args.getBool("RespectDegenerate",respectDegenerate);
+    showEigs = args.getBool("ShowEigs",showEigs);
+    }
+
+TruncateOptions
+diagTruncateDefaults()
+    {
+    auto defaults = TruncateOptions();
+    defaults.truncate = false;
+    defaults.cutoff = 0.;
+    return defaults;
+    }
+
 std::tuple<Real,Real,Real,int>
 truncate(Vector & P,
          long maxdim,
@@ -312,7 +352,27 @@ truncate(Vector & P,
          bool doRelCutoff,
          Args const& args)
     {
-    auto respectDegenerate = args.getBool("RespectDegenerate",false);
+    auto opts = TruncateOptions();
+    opts.maxdim = maxdim;
+    opts.mindim = mindim;
+    opts.cutoff = cutoff;
+    opts.absoluteCutoff = absoluteCutoff;
+    opts.doRelCutoff = doRelCutoff;
+    opts.respectDegenerate = args.getBool("RespectDegenerate",false);
+    return truncate(P,opts);
+    }
+
+// output: truncerr,docut_lower,docut_upper,ndegen_below
+std::tuple<Real,Real,Real,int>
+truncate(Vector & P,
+         TruncateOptions const& opts)
+    {
+    auto maxdim = opts.maxdim;
+    auto mindim = opts.mindim;
+    auto cutoff = opts.cutoff;
+    auto absoluteCutoff = opts.absoluteCutoff;
+    auto doRelCutoff = opts.doRelCutoff;
+    auto respectDegenerate = opts.respectDegenerate;
 
     long origm = P.size();
     long n = origm-1;
@@ -583,6 +643,8 @@ eigDecompImpl(ITensor T,
               ITensor & D,
               Args const& args)
     {
+    TRACE_SCOPE("eig");
+
     auto itagset = getTagSet(args,"Tags","Link");
     // New index listing eigenvectors
     Index newmid;
@@ -1003,6 +1065,7 @@ qrImpl(ITensor const& A,
         ITensor & R,
         Args args)
     {
+    TRACE_SCOPE("qr");
    
     auto internaltagset = getTagSet(args,"InternalTags","Link,QR");
     auto uppertriangular = args.getBool("UpperTriangular",true);
@@ -1033,6 +1096,7 @@ qrImpl(ITensor const& A,
 	vector<std::tuple<int, QNInt, int>> indLiq;
 	auto Liq = Index::qnstorage{};
 	Liq.reserve(Nblock);
+	auto qLblock = vector<int>(Nblock);
 	if (uppertriangular)
 	  indLiq.reserve(Nblock);
 
@@ -1072,6 +1136,9 @@ qrImpl(ITensor const& A,
 	    sort(begin(indLiq),end(indLiq));
 	    std::transform(begin(indLiq), end(indLiq), std::back_inserter(Liq),
 			   [](auto & triplet){ return std::get<1>(triplet);});
+	    //Block of qL holding the columns of Q from block b of A
+	    for(auto p : range(Nblock))
+	      qLblock.at(std::get<2>(indLiq[p])) = p;
 	    if (complete)
 	      {
 		//Add filler rows of zero to R and extra orthonormal rows to Q
@@ -1110,7 +1177,7 @@ qrImpl(ITensor const& A,
             {
 	      int n = b;
 	      if(uppertriangular)
-		n = std::get<2>(indLiq[b]);
+		n = qLblock[b];
 	  
 	      auto& B = blocks[b];
 	      
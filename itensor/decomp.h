@@ -16,12 +16,44 @@
 #ifndef __ITENSOR_DECOMP_H
 #define __ITENSOR_DECOMP_H
 //#include "itensor/util/print_macro.h"
+#include <limits>
 #include "itensor/spectrum.h"
 #include "itensor/itensor.h"
 
 
 namespace itensor {
 
+//
+// Truncation options used by svd, diag_hermitian
+// and denmatDecomp:
+//   Truncate, Cutoff, MaxDim, MinDim, DoRelCutoff,
+//   AbsoluteCutoff, RespectDegenerate, ShowEigs
+// The Args constructor also accepts the deprecated names
+// Minm and Maxm. Loops performing many decompositions
+// (such as DMRG sweeps) can construct a TruncateOptions
+// once and pass it down instead of Args.
+//
+struct TruncateOptions
+    {
+    bool truncate = true;
+    Real cutoff = 0.;
+    long maxdim = std::numeric_limits<long>::max();
+    long mindim = 1;
+    bool doRelCutoff = true;
+    bool absoluteCutoff = false;
+    bool respectDegenerate = false;
+    bool showEigs = false;
+
+    TruncateOptions() { }
+
+    //Options not defined in args take their values from defaults,
+    //except Truncate which (if not defined) is true whenever
+    //Cutoff or MaxDim is defined
+    explicit
+    TruncateOptions(Args const& args,
+                    TruncateOptions const& defaults = TruncateOptions());
+    };
+
 //
 // Singular value decomposition (SVD)
 //
@@ -32,6 +64,17 @@ Spectrum
 svd(ITensor const& AA, ITensor& U, ITensor& D, ITensor& V, 
     Args args = Args::global());
 
+//Version taking the truncation options already parsed
+//(options such as "LeftTags" are still read from args)
+Spectrum 
+svd(ITensor const& AA, ITensor& U, ITensor& D, ITensor& V, 
+    TruncateOptions opts,
+    Args const& args = Args::global());
+
+//Defaults used by svd for options not defined in Args
+TruncateOptions
+svdTruncateDefaults();
+
 std::tuple<ITensor,ITensor,ITensor>
 svd(ITensor const& AA, IndexSet const& Uis, IndexSet const& Vis, 
     Args args = Args::global());
@@ -95,6 +138,12 @@ factor(ITensor const& T, Index const& i1, IndsArgs&&... indsargs);
 // Implementation is faster than SVD, though, and allows the
 // noise term to be used.
 //
+// With the argument "EigMethod" set to "syevr" (default "syev")
+// only the MaxDim+1 largest eigenpairs of the density matrix are
+// computed, which is much faster when MaxDim is small compared
+// to the dimension of the density matrix. The truncation error is
+// the same. The same argument is accepted by diagPosSemiDef.
+//
 // To determine which indices end up on which factors (i.e. on A versus B),
 // the method examines the initial indices of A and B.
 // If a given index is present on, say, A, then it will on A 
@@ -300,6 +349,16 @@ svdOrd2(ITensor const& A,
         ITensor & V,
         Args args = Args::global());
 
+Spectrum 
+svdOrd2(ITensor const& A, 
+        Index const& ui, 
+        Index const& vi,
+        ITensor & U, 
+        ITensor & D, 
+        ITensor & V,
+        TruncateOptions const& opts,
+        Args const& args = Args::global());
+
 void qrOrd2(ITensor const& A, 
         Index const& Qi, 
         Index const& Ri,
@@ -313,6 +372,28 @@ diag_hermitian(ITensor  rho,
                ITensor  & D,
                Args const& args);
 
+Spectrum
+diag_hermitian(ITensor  rho, 
+               ITensor  & U, 
+               ITensor  & D,
+               TruncateOptions const& opts,
+               Args const& args = Args::global());
+
+//Defaults used by diag_hermitian and denmatDecomp
+//for options not defined in Args
+TruncateOptions
+diagTruncateDefaults();
+
+template<class BigMatrixT>
+Spectrum 
+denmatDecomp(ITensor const& AA, 
+             ITensor & A, 
+             ITensor & B, 
+             Direction dir, 
+             BigMatrixT const& PH,
+             TruncateOptions opts,
+             Args args = Args::global());
+
 template<class BigMatrixT>
 Spectrum 
 denmatDecomp(ITensor const& AA, 
@@ -322,32 +403,19 @@ denmatDecomp(ITensor const& AA,
              BigMatrixT const& PH,
              Args args)
     {
-    if( args.defined("Minm") )
-      {
-      if( args.defined("MinDim") )
-        {
-        Global::warnDeprecated("Args Minm and MinDim are both defined. Minm is deprecated in favor of MinDim, MinDim will be used.");
-        }
-      else
-        {
-        Global::warnDeprecated("Arg Minm is deprecated in favor of MinDim.");
-        args.add("MinDim",args.getInt("Minm"));
-        }
-      }
-
-    if( args.defined("Maxm") )
-      {
-      if( args.defined("MaxDim") )
-        {
-        Global::warnDeprecated("Args Maxm and MaxDim are both defined. Maxm is deprecated in favor of MaxDim, MaxDim will be used.");
-        }
-      else
-        {
-        Global::warnDeprecated("Arg Maxm is deprecated in favor of MaxDim.");
-        args.add("MaxDim",args.getInt("Maxm"));
-        }
-      }
+    return denmatDecomp(AA,A,B,dir,PH,TruncateOptions(args,diagTruncateDefaults()),args);
+    }
 
+template<class BigMatrixT>
+Spectrum 
+denmatDecomp(ITensor const& AA, 
+             ITensor & A, 
+             ITensor & B, 
+             Direction dir, 
+             BigMatrixT const& PH,
+             TruncateOptions opts,
+             Args args)
+    {
     //TODO: decide on a tag convention for denmatDecomp
     if(!args.defined("Tags")) args.add("Tags","Link");
     auto noise = args.getReal("Noise",0.);
@@ -396,16 +464,17 @@ denmatDecomp(ITensor const& AA,
 
     if(args.getBool("UseOrigM",false))
         {
-        args.add("Cutoff",-1);
-        args.add("MinDim",dim(mid));
-        args.add("MaxDim",dim(mid));
+        opts.truncate = args.getBool("Truncate",true);
+        opts.cutoff = -1;
+        opts.mindim = dim(mid);
+        opts.maxdim = dim(mid);
         }
 
     if(args.getBool("TraceReIm",false))
         rho = realPart(rho);
 
     ITensor U,D;
-    auto spec = diag_hermitian(rho,U,D,args);
+    auto spec = diag_hermitian(rho,U,D,opts,args);
 
     cmb.dag();
 
@@ -427,6 +496,10 @@ truncate(Vector & P,
          bool doRelCutoff = false,
          Args const& args = Args::global());
 
+std::tuple<Real,Real,Real,int>
+truncate(Vector & P,
+         TruncateOptions const& opts);
+
 template<typename V>
 MatRefc<V>
 toMatRefc(ITensor const& T, 
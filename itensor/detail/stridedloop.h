@@ -0,0 +1,238 @@
+//
+// Copyright 2018 The Simons Foundation, Inc. - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef __ITENSOR_STRIDEDLOOP_H
+#define __ITENSOR_STRIDEDLOOP_H
+
+#include <algorithm>
+#include "itensor/util/infarray.h"
+
+namespace itensor {
+namespace detail {
+
+//
+// Loop nests of fixed order, used by stridedLoop below
+//
+
+template<int R>
+struct StridedLoopImpl
+    {
+    template<typename F>
+    static void
+    run(long const* ext,
+        long const* sa,
+        long const* sb,
+        long oa,
+        long ob,
+        F & f)
+        {
+        for(long i = 0; i < ext[R-1]; ++i)
+            {
+            StridedLoopImpl<R-1>::run(ext,sa,sb,oa+i*sa[R-1],ob+i*sb[R-1],f);
+            }
+        }
+    };
+
+template<>
+struct StridedLoopImpl<1>
+    {
+    template<typename F>
+    static void
+    run(long const* ext,
+        long const* sa,
+        long const* sb,
+        long oa,
+        long ob,
+        F & f)
+        {
+        auto n = ext[0];
+        auto a = sa[0],
+             b = sb[0];
+        if(a == 1 && b == 1)
+            {
+            //Unit strides known at compile time
+            //so this loop can be vectorized
+            for(long i = 0; i < n; ++i) f(oa+i,ob+i);
+            }
+        else
+            {
+            for(long i = 0; i < n; ++i) f(oa+i*a,ob+i*b);
+            }
+        }
+    };
+
+template<int R, typename F>
+void
+stridedLoopOrder(long const* ext,
+                 long const* sa,
+                 long const* sb,
+                 long oa,
+                 long ob,
+                 F & f)
+    {
+    StridedLoopImpl<R>::run(ext,sa,sb,oa,ob,f);
+    }
+
+//
+// Call f(oa,ob) for every element of a box of order r and
+// extents ext[0],...,ext[r-1], where oa = sum_j i_j*sa[j]
+// and ob = sum_j i_j*sb[j] are the offsets of the element
+// in two tensors with strides sa and sb.
+//
+// Before looping, indices of extent 1 are dropped, the
+// remaining ones are ordered by increasing stride sb (so
+// the innermost loop walks the second tensor contiguously
+// when possible) and indices which are contiguous in both
+// tensors are fused. The loop nest for the resulting order
+// (up to 8) is then selected once, instead of incrementing
+// a general counter for every element.
+//
+template<typename F>
+void
+stridedLoop(long r,
+            long const* ext,
+            long const* sa,
+            long const* sb,
+            F&& f)
+    {
+    constexpr long MaxOrd = 8;
+    using Dims = InfArray<long,11ul>;
+    auto E = Dims(r),
+         A = Dims(r),
+         B = Dims(r);
+    long n = 0;
+    for(long j = 0; j < r; ++j)
+        {
+        if(ext[j] == 0) return;
+        if(ext[j] == 1) continue;
+        //Insertion sort by stride of b
+        auto p = n;
+        for(; p > 0 && B[p-1] > sb[j]; --p)
+            {
+            E[p] = E[p-1];
+            A[p] = A[p-1];
+            B[p] = B[p-1];
+            }
+        E[p] = ext[j];
+        A[p] = sa[j];
+        B[p] = sb[j];
+        ++n;
+        }
+
+    //Fuse neighboring indices which are contiguous in both
+    auto nf = 0l;
+    for(long j = 0; j < n; ++j)
+        {
+        if(nf > 0 && A[j] == E[nf-1]*A[nf-1] && B[j] == E[nf-1]*B[nf-1])
+            {
+            E[nf-1] *= E[j];
+            continue;
+            }
+        E[nf] = E[j];
+        A[nf] = A[j];
+        B[nf] = B[j];
+        ++nf;
+        }
+    n = nf;
+
+    if(n == 0)
+        {
+        f(0l,0l);
+        return;
+        }
+
+    //Orders beyond MaxOrd: count over the outer
+    //indices and run the order MaxOrd loop inside
+    auto ninner = std::min(n,MaxOrd);
+    auto outer = Dims(n,0);
+    auto oa = 0l,
+         ob = 0l;
+    while(true)
+        {
+        switch(ninner)
+            {
+            case 1: stridedLoopOrder<1>(E.data(),A.data(),B.data(),oa,ob,f); break;
+            case 2: stridedLoopOrder<2>(E.data(),A.data(),B.data(),oa,ob,f); break;
+            case 3: stridedLoopOrder<3>(E.data(),A.data(),B.data(),oa,ob,f); break;
+            case 4: stridedLoopOrder<4>(E.data(),A.data(),B.data(),oa,ob,f); break;
+            case 5: stridedLoopOrder<5>(E.data(),A.data(),B.data(),oa,ob,f); break;
+            case 6: stridedLoopOrder<6>(E.data(),A.data(),B.data(),oa,ob,f); break;
+            case 7: stridedLoopOrder<7>(E.data(),A.data(),B.data(),oa,ob,f); break;
+            default: stridedLoopOrder<8>(E.data(),A.data(),B.data(),oa,ob,f); break;
+            }
+        //Increment the outer indices
+        auto j = ninner;
+        for(; j < n; ++j)
+            {
+            ++outer[j];
+            oa += A[j];
+            ob += B[j];
+            if(outer[j] < E[j]) break;
+            oa -= outer[j]*A[j];
+            ob -= outer[j]*B[j];
+            outer[j] = 0;
+            }
+        if(j >= n) return;
+        }
+    }
+
+//
+// Same as stridedLoop, but for large boxes the index of
+// largest extent is cut into pieces which are looped over
+// by separate OpenMP threads. Only valid if f(oa,ob) just
+// modifies element ob of the second tensor and no two
+// elements of the box have the same offset ob.
+//
+template<typename F>
+void
+parallelStridedLoop(long r,
+                    long const* ext,
+                    long const* sa,
+                    long const* sb,
+                    F&& f)
+    {
+    constexpr long PieceSize = 1l << 16;
+    long size = 1,
+         jmax = 0;
+    for(long j = 0; j < r; ++j)
+        {
+        size *= ext[j];
+        if(ext[j] > ext[jmax]) jmax = j;
+        }
+    auto npiece = (r > 0) ? std::min(ext[jmax],size/PieceSize) : 0l;
+    if(npiece < 2)
+        {
+        stridedLoop(r,ext,sa,sb,f);
+        return;
+        }
+    auto len = (ext[jmax]+npiece-1)/npiece;
+    npiece = (ext[jmax]+len-1)/len;
+#pragma omp parallel for schedule(static)
+    for(long p = 0; p < npiece; ++p)
+        {
+        auto E = InfArray<long,11ul>(r);
+        std::copy(ext,ext+r,E.begin());
+        auto i0 = p*len;
+        E[jmax] = std::min(len,ext[jmax]-i0);
+        auto oa = i0*sa[jmax],
+             ob = i0*sb[jmax];
+        stridedLoop(r,E.data(),sa,sb,[&f,oa,ob](long a, long b) { f(oa+a,ob+b); });
+        }
+    }
+
+} //namespace detail
+} //namespace itensor
+
+#endif
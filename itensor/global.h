@@ -28,6 +28,7 @@
 #include "itensor/util/args.h"
 #include "itensor/real.h"
 #include "itensor/util/timers.h"
+#include "itensor/util/trace.h"
 #include "itensor/detail/algs.h"
 
 namespace itensor {
@@ -37,60 +37,67 @@ using std::sqrt;
 using std::move;
 using std::tie;
 
+//
+// Diagonalize the Hermitian matrix M keeping only its k
+// largest eigenpairs (U gets k columns). The last nrows(M)-k
+// entries of d, which must have room for all eigenvalues, are
+// set to the mean of the eigenvalues not computed (found from
+// the trace of M). Truncating d to k or fewer values then gives
+// the same truncation error as the full spectrum would for
+// positive semi-definite M, such as a density matrix.
+//
+template<typename MatM, typename MatU>
+void
+diagLargest(MatM const& M,
+            MatU && U,
+            VectorRef const& d,
+            long k)
+    {
+    auto N = long(nrows(M));
+    diagHermitian(M,U,subVector(d,0,k),k);
+    Real rest = 0;
+    for(auto j : range(N)) rest += std::real(M(j,j));
+    for(auto j : range(k)) rest -= d(j);
+    for(auto j : range(k,N)) d(j) = rest/(N-k);
+    }
+
 template<typename T>
 Spectrum
 diagHImpl(ITensor H, 
           ITensor& U, 
           ITensor& D,
-          Args args)
+          TruncateOptions opts,
+          Args const& args)
     {
-    if( args.defined("Minm") )
-      {
-      if( args.defined("MinDim") )
-        {
-        Global::warnDeprecated("Args Minm and MinDim are both defined. Minm is deprecated in favor of MinDim, MinDim will be used.");
-        }
-      else
-        {
-        Global::warnDeprecated("Arg Minm is deprecated in favor of MinDim.");
-        args.add("MinDim",args.getInt("Minm"));
-        }
-      }
-
-    if( args.defined("Maxm") )
-      {
-      if( args.defined("MaxDim") )
-        {
-        Global::warnDeprecated("Args Maxm and MaxDim are both defined. Maxm is deprecated in favor of MaxDim, MaxDim will be used.");
-        }
-      else
-        {
-        Global::warnDeprecated("Arg Maxm is deprecated in favor of MaxDim.");
-        args.add("MaxDim",args.getInt("Maxm"));
-        }
-      }
-
-    auto origdim = dim(H.inds().front());
-    auto cutoff = args.getReal("Cutoff",0.);
-    auto maxdim = args.getInt("MaxDim",origdim);
-    auto mindim = args.getInt("MinDim",1);
-    auto def_do_trunc = args.defined("Cutoff") || args.defined("MaxDim");
-    auto do_truncate = args.getBool("Truncate",def_do_trunc);
-    auto doRelCutoff = args.getBool("DoRelCutoff",true);
-    auto absoluteCutoff = args.getBool("AbsoluteCutoff",false);
-    auto showeigs = args.getBool("ShowEigs",false);
-    auto itagset = getTagSet(args,"Tags","Link");
+    TRACE_SCOPE("eig");
 
+    long origdim = dim(H.inds().front());
     // If no truncation is occuring, reset MaxDim
     // to the full matrix dimension
-    if(!do_truncate)
+    if(!opts.truncate || opts.maxdim > origdim) opts.maxdim = origdim;
+
+    auto cutoff = opts.cutoff;
+    auto maxdim = opts.maxdim;
+    auto mindim = opts.mindim;
+    auto do_truncate = opts.truncate;
+    auto doRelCutoff = opts.doRelCutoff;
+    auto absoluteCutoff = opts.absoluteCutoff;
+    auto showeigs = opts.showEigs;
+    auto itagset = getTagSet(args,"Tags","Link");
+
+    // With "EigMethod" set to "syevr", only the eigenvalues
+    // which can survive truncation to maxdim are computed
+    auto eig_method = args.getString("EigMethod","syev");
+    if(eig_method != "syev" && eig_method != "syevr")
         {
-        if(args.defined("MaxDim"))
-            {
-            args.add("MaxDim",origdim);
-            maxdim = origdim;
-            }
+        Error(format("EigMethod %s not recognized",eig_method));
         }
+    //Number of eigenpairs to compute for a matrix of size n
+    auto numEigs = [&](long n) -> long
+        {
+        if(eig_method == "syevr" && do_truncate) return std::min(n,maxdim+1);
+        return n;
+        };
 
     if(not hasQNs(H))
         {
@@ -122,7 +129,16 @@ diagHImpl(ITensor H,
         Vector DD;
         Mat<T> UU,iUU;
         auto R = toMatRefc<T>(H,active,prime(active));
-        diagHermitian(R,UU,DD);
+        auto neig = numEigs(origdim);
+        if(neig < origdim)
+            {
+            DD = Vector(origdim);
+            diagLargest(R,UU,makeRef(DD),neig);
+            }
+        else
+            {
+            diagHermitian(R,UU,DD);
+            }
         conjugate(UU);
 
         //Truncate
@@ -134,7 +150,7 @@ diagHImpl(ITensor H,
         if(do_truncate)
             {
             //if(DD(1) < 0) DD *= -1; //DEBUG
-            tie(truncerr,docut_lower,docut_upper,ndegen) = truncate(DD,maxdim,mindim,cutoff,absoluteCutoff,doRelCutoff,args);
+            tie(truncerr,docut_lower,docut_upper,ndegen) = truncate(DD,opts);
             m = DD.size();
             reduceCols(UU,m);
             }
@@ -237,9 +253,20 @@ diagHImpl(ITensor H,
                  cM = ncols(M);
 
             d = makeVecRef(ddata.data()+totaldsize,rM);
-            UU = makeMatRef(Udata.data()+totalUsize,rM*cM,rM,cM);
-
-            diagHermitian(M,UU,d);
+            //At most maxdim eigenvalues are kept overall, so the
+            //rest of each block can be left out after the first
+            //maxdim+1 (which diagLargest needs for the truncation)
+            auto neig = numEigs(rM);
+            if(neig < long(rM))
+                {
+                UU = makeMatRef(Udata.data()+totalUsize,rM*neig,rM,neig);
+                diagLargest(M,UU,d,neig);
+                }
+            else
+                {
+                UU = makeMatRef(Udata.data()+totalUsize,rM*cM,rM,cM);
+                diagHermitian(M,UU,d);
+                }
             conjugate(UU);
 
             alleig.insert(alleig.end(),d.begin(),d.end());
@@ -432,11 +459,21 @@ diag_hermitian(ITensor    H,
                ITensor  & D,
                Args const& args)
     {
+    return diag_hermitian(H,U,D,TruncateOptions(args,diagTruncateDefaults()),args);
+    }
+
+Spectrum
+diag_hermitian(ITensor    H, 
+               ITensor  & U, 
+               ITensor  & D,
+               TruncateOptions const& opts,
+               Args const& args)
+    {
     if(isComplex(H))
         {
-        return diagHImpl<Cplx>(H,U,D,args);
+        return diagHImpl<Cplx>(H,U,D,opts,args);
         }
-    return diagHImpl<Real>(H,U,D,args);
+    return diagHImpl<Real>(H,U,D,opts,args);
     }
 
 } //namespace itensor
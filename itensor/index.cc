@@ -52,6 +52,23 @@ generateID()
     return G();
     }
 
+void Index::
+updateFingerprint()
+    {
+    //FNV-1a style mixing of the id, prime level and tags
+    auto mix = [](size_t h, uint64_t x)
+        {
+        h ^= x;
+        h *= 1099511628211ul;
+        return h ^ (h >> 29);
+        };
+    size_t h = 14695981039346656037ul;
+    h = mix(h,id_);
+    h = mix(h,uint64_t(tags_.primeLevel()));
+    for(auto i : range(tags_.size())) h = mix(h,uint64_t(int64_t(tags_[i])));
+    fingerprint_ = h;
+    }
+
 Index::
 Index() 
     : 
@@ -60,6 +77,7 @@ Index()
     tags_(TagSet("0"))
     {
     if(primeLevel() < 0) setPrime(0);
+    updateFingerprint();
     }
 
 Index::
@@ -70,6 +88,7 @@ Index(long m,
     tags_(t)
     { 
     if(primeLevel() < 0) setPrime(0);
+    updateFingerprint();
     } 
 
 Index::
@@ -83,6 +102,7 @@ Index(id_type id,
     tags_(ts)
     { 
     if(primeLevel() < 0) setPrime(0);
+    updateFingerprint();
     } 
 
 Index::
@@ -98,6 +118,7 @@ Index(id_type id,
     { 
     makeStorage(std::move(qns));
     if(primeLevel() < 0) setPrime(0);
+    updateFingerprint();
     } 
 
 
@@ -109,6 +130,7 @@ setPrime(int plev)
     if(this->primeLevel() < 0)
         Error("Negative primeLevel");
 #endif
+    updateFingerprint();
     return *this;
     }
 
@@ -117,6 +139,7 @@ Index& Index::
 noPrime()  
     {
     tags_.setPrime(0);
+    updateFingerprint();
     return *this;
     }
 
@@ -131,6 +154,7 @@ prime(int inc)
         Error("Negative primeLevel");
         }
 #endif
+    updateFingerprint();
     return *this;
     }
 
@@ -150,12 +174,6 @@ operator=(long val) const
     return operator()(val); 
     }
 
-bool 
-operator==(Index const& i1, Index const& i2)
-    { 
-    return (id(i1) == id(i2)) && (tags(i1) == tags(i2));
-    }
-
 bool 
 operator!=(Index const& i1, Index const& i2)
     { 
@@ -746,6 +764,7 @@ read(std::istream& s)
     if(tags_.primeLevel() < 0) Error("Negative primeLevel");
 #endif
 
+    updateFingerprint();
     return *this;
     }
 
@@ -91,6 +91,7 @@ class Index
     Arrow dir_ = Out;
     qn_ptr pd;
     TagSet tags_;
+    size_t fingerprint_ = 0;
     public:
 
     Index();
@@ -133,6 +134,13 @@ class Index
     id_type
     id() const { return id_; }
 
+    // Hash of the id, tags and prime level.
+    // Equal Indices have equal fingerprints, so
+    // comparing fingerprints quickly rules out
+    // most non-matching Indices.
+    size_t
+    fingerprint() const { return fingerprint_; }
+
     // Evaluates to false if Index is default constructed.
     explicit operator bool() const;
 
@@ -143,23 +151,23 @@ class Index
 
     // Add tags
     Index&
-    addTags(const TagSet& t) { tags_.addTags(t); return *this; }
+    addTags(const TagSet& t) { tags_.addTags(t); updateFingerprint(); return *this; }
 
     // Remove tags
     Index&
-    removeTags(const TagSet& t) { tags_.removeTags(t); return *this; }
+    removeTags(const TagSet& t) { tags_.removeTags(t); updateFingerprint(); return *this; }
 
     // Set tags
     Index&
-    setTags(const TagSet& t) { tags_.setTags(t); return *this; }
+    setTags(const TagSet& t) { tags_.setTags(t); updateFingerprint(); return *this; }
 
     // Remove all tags
     Index&
-    noTags() { tags_.noTags(); return *this; }
+    noTags() { tags_.noTags(); updateFingerprint(); return *this; }
 
     // Set tags
     Index&
-    replaceTags(const TagSet& tsold, const TagSet& tsnew) { tags_.replaceTags(tsold,tsnew); return *this; }
+    replaceTags(const TagSet& tsold, const TagSet& tsnew) { tags_.replaceTags(tsold,tsnew); updateFingerprint(); return *this; }
 
     // Sets the prime level to a specified value.
     Index& 
@@ -225,6 +233,7 @@ class Index
       {
       *this = I;
       id_ = generateID();
+      updateFingerprint();
       return *this;
       }
 
@@ -236,6 +245,9 @@ class Index
     Index::id_type 
     generateID();
 
+    void
+    updateFingerprint();
+
     public:
 
     //
@@ -282,8 +294,12 @@ class Index
     }; //class Index
 
 // i1 compares equal to i2 if i2 is a copy of i1 with same primelevel
-bool 
-operator==(Index const& i1, Index const& i2);
+bool inline
+operator==(Index const& i1, Index const& i2)
+    {
+    return (i1.fingerprint() == i2.fingerprint())
+           && (i1.id() == i2.id()) && (i1.tags() == i2.tags());
+    }
 bool 
 operator!=(Index const& i1, Index const& i2);
 
@@ -16,6 +16,7 @@
 #ifndef __ITENSOR_INDEXSET_H
 #define __ITENSOR_INDEXSET_H
 #include <algorithm>
+#include "itensor/detail/gcounter.h"
 #include "itensor/util/safe_ptr.h"
 #include "itensor/index.h"
 #include "itensor/tensor/contract.h"
@@ -21,6 +21,7 @@
 #include "itensor/tensor/sliceten.h"
 #include "itensor/tensor/contract.h"
 #include "itensor/tensor/lapack_wrap.h"
+#include "itensor/tensor/elementwise.h"
 #include "itensor/util/tensorstats.h"
 
 using std::move;
@@ -112,7 +113,7 @@ doTask(Fill<Cplx> const& f, DenseCplx & D)
 void
 doTask(Mult<Cplx> const& M, Dense<Cplx> & D)
     {
-    for(auto& el : D) el *= M.x;
+    scalKernel(D.size(),M.x,D.data());
     }
 void
 doTask(Mult<Cplx> const& M, Dense<Real> const& D, ManageStore & m)
@@ -126,7 +127,7 @@ void
 doTask(Mult<Real> const& M, Dense<T> & D)
     {
     auto d = realData(D);
-    dscal_wrapper(d.size(),M.x,d.data());
+    scalKernel(d.size(),M.x,d.data());
     }
 template
 void
@@ -152,7 +153,7 @@ Real
 doTask(NormNoScale, Dense<T> const& D) 
     { 
     auto d = realData(D);
-    return dnrm2_wrapper(d.size(),d.data());
+    return nrm2Kernel(d.size(),d.data());
     }
 template
 Real
@@ -167,7 +168,7 @@ doTask(Conj,DenseReal const& D) { /*Nothing to conj*/ }
 void
 doTask(Conj,DenseCplx & D) 
     { 
-    for(auto& el : D) el = std::conj(el);
+    conjKernel(D.size(),D.data());
     }
 
 void
@@ -271,6 +272,13 @@ doTask(Contract & C,
     //    m.makeNewData<ITLazy>(C.Lis,m.parg1(),C.Ris,m.parg2());
     //    return;
     //    }
+    using T3 = common_type<T1,T2>;
+    //Write into the destination storage if
+    //it has the size of the result
+    auto* dest = C.into ? uniqueStorage<Dense<T3>>(*C.into) : nullptr;
+    if(dest && dest->size() == dim(*C.intoIs)) C.Nis = *C.intoIs;
+    else                                       dest = nullptr;
+
     Labels Lind,
            Rind,
            Nind;
@@ -303,6 +311,13 @@ doTask(Contract & C,
         }
     auto tL = makeTenRef(L.data(),L.size(),&C.Lis);
     auto tR = makeTenRef(R.data(),R.size(),&C.Ris);
+    if(dest)
+        {
+        auto tN = makeTenRef(dest->data(),dest->size(),&(C.Nis));
+        contract(tL,Lind,tR,Rind,tN,Nind,C.alpha,C.beta);
+        C.wroteInto = true;
+        return;
+        }
     auto rsize = dim(C.Nis);
 TIMER_START(40);
     // Create a Dense storage with undefined data, since it will be
@@ -377,18 +392,25 @@ add(PlusEQ const& P,
 #ifdef DEBUG
     if(D1.size() != D2.size()) Error("Mismatched sizes in plusEq");
 #endif
-    if(isTrivial(P.perm()) && std::is_same<T1,T2>::value)
+    if(isTrivial(P.perm()))
         {
-        auto d1 = realData(D1);
-        auto d2 = realData(D2);
-        daxpy_wrapper(d1.size(),P.alpha(),d2.data(),1,d1.data(),1);
-        }
-    else
-        {
-        auto ref1 = makeTenRef(D1.data(),D1.size(),&P.is1());
-        auto ref2 = makeTenRef(D2.data(),D2.size(),&P.is2());
-        transform(permute(ref2,P.perm()),ref1,Adder{P.alpha()});
+        if constexpr(std::is_same<T1,T2>::value)
+            {
+            auto d1 = realData(D1);
+            auto d2 = realData(D2);
+            axpyKernel(d1.size(),P.alpha(),d2.data(),d1.data());
+            return;
+            }
+        else if constexpr(std::is_same<T1,Cplx>::value)
+            {
+            axpyKernel(D1.size(),P.alpha(),D2.data(),D1.data());
+            return;
+            }
         }
+    //Permute D2 on the fly while adding it to D1
+    auto ref1 = makeTenRef(D1.data(),D1.size(),&P.is1());
+    auto ref2 = makeTenRef(D2.data(),D2.size(),&P.is2());
+    parallelTransform(permute(ref2,P.perm()),ref1,Adder{P.alpha()});
     }
 
 template<typename T1, typename T2>
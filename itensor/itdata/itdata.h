@@ -327,6 +327,19 @@ modifyData(const T& d)
     return &(a1->d);
     }
 
+//
+// Storage held by p if it is of type T and not
+// shared with another ITensor, otherwise nullptr
+//
+template<typename T>
+T*
+uniqueStorage(PData const& p)
+    {
+    if(!p || !p.unique()) return nullptr;
+    auto* w = dynamic_cast<ITWrap<T>*>(p.get());
+    return w ? &(w->d) : nullptr;
+    }
+
 
 inline ITData& CPData::
 operator*() { return *p; }
@@ -181,10 +181,9 @@ combine(QDense<T> const& d,
         drange.init(make_indexdim(dis,io.block));
         auto dref = makeTenRef(d.data(),io.offset,d.size(),&drange);
 
-        //Permute combined indices to front, then
-        //group the first ncomb indices into one
-        auto Pdref = Ten<Range,T>{permute(dref,dperm)};
-        auto gPdref = groupInds(Pdref,0,ncomb);
+        //View of this block with the combined indices
+        //permuted to the front (no data is moved yet)
+        auto Pdref = permute(dref,dperm);
 
         //Figure out "block index" where this block will
         //go in new storage (nblock) and which sector of
@@ -208,7 +207,20 @@ combine(QDense<T> const& d,
 
         //Slice this new-storage block to get subblock where data will go
         auto nsub = subIndex(nref,0,start,end);
-        nsub &= gPdref;
+
+        //Split the combined index of the slice back into the
+        //ncomb combined indices, so the permuted block can be
+        //copied in directly (a single pass over the data)
+        auto rb = RangeBuilder(ncomb+nr-1);
+        auto str = nsub.stride(0);
+        for(auto c : range(ncomb))
+            {
+            rb.setIndStr(c,Pdref.extent(c),str);
+            str *= Pdref.extent(c);
+            }
+        for(auto j : range(1,nr)) rb.setIndStr(ncomb+j-1,nsub.extent(j),nsub.stride(j));
+        auto nsplit = makeRef(nsub.store(),rb.build());
+        nsplit &= Pdref;
         }
     }
 
@@ -14,14 +14,17 @@
 // limitations under the License.
 //
 //#include "itensor/util/iterate.h"
+#include <limits>
 #include "itensor/detail/gcounter.h"
 #include "itensor/detail/algs.h"
 #include "itensor/tensor/lapack_wrap.h"
+#include "itensor/tensor/elementwise.h"
 #include "itensor/tensor/sliceten.h"
 #include "itensor/tensor/contract.h"
 #include "itensor/itdata/dense.h"
 #include "itensor/itdata/qdense.h"
 #include "itensor/itdata/qutil.h"
+#include "itensor/util/contractprofiler.h"
 #include "itensor/util/print_macro.h"
 
 using std::vector;
@@ -179,6 +182,7 @@ updateOffsets(IndexSet const& is,
     {
     auto [bofs,size] = getBlockOffsets(is,div);
     offsets = bofs;
+    resetBlockLookup();
     return size;
     }
 
@@ -188,6 +192,7 @@ updateOffsets(IndexSet const& is,
               Blocks   const& blocks)
     {
     offsets.clear();
+    resetBlockLookup();
 
     if(order(is)==0)
         {
@@ -229,6 +234,105 @@ offsetOfLoc(BlockOffsets const& offsets,
     return loc;
     }
 
+//Use a flat table as long as it is at most
+//this many times larger than the number of blocks
+const size_t blockTableFill = 8;
+//Below this number of blocks a binary search is used
+const size_t blockLookupMin = 16;
+
+bool BlockLookup::
+canIndex(IndexSet const& is)
+    {
+    size_t tot = 1;
+    for(auto j : range(order(is)))
+        {
+        auto nb = size_t(is[j].nblock());
+        if(nb == 0 || tot > std::numeric_limits<size_t>::max()/nb) return false;
+        tot *= nb;
+        }
+    return true;
+    }
+
+BlockLookup::
+BlockLookup(IndexSet const& is,
+            BlockOffsets const& offsets)
+  : stride_(order(is)),
+    nblocks_(offsets.size())
+    {
+    size_t tot = 1;
+    for(auto j : range(order(is)))
+        {
+        stride_[j] = tot;
+        tot *= is[j].nblock();
+        }
+    if(tot <= blockTableFill*nblocks_)
+        {
+        table_.assign(tot,-1);
+        for(auto n : range(nblocks_)) table_[linearId(offsets[n].block)] = n;
+        }
+    else
+        {
+        sparse_.reserve(nblocks_);
+        for(auto n : range(nblocks_)) sparse_[linearId(offsets[n].block)] = n;
+        }
+    }
+
+bool BlockLookup::
+valid(IndexSet const& is,
+      BlockOffsets const& offsets) const
+    {
+    if(offsets.size() != nblocks_ || size_t(order(is)) != stride_.size()) return false;
+    size_t tot = 1;
+    for(auto j : range(order(is)))
+        {
+        if(stride_[j] != tot) return false;
+        tot *= is[j].nblock();
+        }
+    return true;
+    }
+
+long BlockLookup::
+find(Block const& block) const
+    {
+    auto id = linearId(block);
+    if(!table_.empty()) return table_[id];
+    auto it = sparse_.find(id);
+    return it == sparse_.end() ? -1 : it->second;
+    }
+
+long
+findBlockLoc(std::shared_ptr<const BlockLookup> & lookup,
+             IndexSet const& is,
+             BlockOffsets const& offsets,
+             Block const& blockind)
+    {
+    if(offsets.size() >= blockLookupMin)
+        {
+        //Several threads may get here at once for the same
+        //storage; each then builds an equivalent table
+        auto L = std::atomic_load(&lookup);
+        if(!L || !L->valid(is,offsets))
+            {
+            if(BlockLookup::canIndex(is))
+                {
+                L = std::make_shared<const BlockLookup>(is,offsets);
+                std::atomic_store(&lookup,L);
+                }
+            }
+        if(L && L->valid(is,offsets))
+            {
+            //A hit is checked against offsets; a miss, or a hit
+            //from a table made stale by modifying offsets without
+            //resetting it, falls back to the binary search
+            auto loc = L->find(blockind);
+            if(loc >= 0 && offsets[loc].block == blockind) return loc;
+            }
+        }
+    auto it = std::lower_bound(offsets.begin(),offsets.end(),blockind,compBlock());
+    if(it != offsets.end() && it->block == blockind) return std::distance(offsets.begin(),it);
+    return -1;
+    }
+
 Cplx
 doTask(GetElt& G, QDenseReal const& d)
     {
@@ -305,7 +409,7 @@ void
 doTask(Mult<Real> const& M, QDense<T>& D)
     {
     auto d = realData(D);
-    dscal_wrapper(d.size(),M.x,d.data());
+    scalKernel(d.size(),M.x,d.data());
     }
 template void doTask(Mult<Real> const&, QDenseReal&);
 template void doTask(Mult<Real> const&, QDenseCplx&);
@@ -314,7 +418,7 @@ template void doTask(Mult<Real> const&, QDenseCplx&);
 void
 doTask(Mult<Cplx> const& M, QDense<Cplx> & d)
     {
-    for(auto& el : d) el *= M.x;
+    scalKernel(d.size(),M.x,d.data());
     }
 
 void
@@ -376,7 +480,7 @@ template void doTask(Fill<Cplx> const& F, QDense<Real> const&, ManageStore &);
 void
 doTask(Conj, QDenseCplx & d)
     {
-    for(auto& el : d) applyConj(el);
+    conjKernel(d.size(),d.data());
     }
 
 void
@@ -411,7 +515,7 @@ Real
 doTask(NormNoScale, QDense<T> const& D)
     { 
     auto d = realData(D);
-    return dnrm2_wrapper(d.size(),d.data());
+    return nrm2Kernel(d.size(),d.data());
     }
 template Real doTask(NormNoScale, QDense<Real> const& D);
 template Real doTask(NormNoScale, QDense<Cplx> const& D);
@@ -512,6 +616,21 @@ struct Adder
     void operator()(Cplx v2, Real& v1) { }
     };
 
+//Whether A and B have the same blocks at the same offsets
+template<typename T1, typename T2>
+bool
+sameBlocks(QDense<T1> const& A,
+           QDense<T2> const& B)
+    {
+    if(A.offsets.size() != B.offsets.size()) return false;
+    for(auto n : range(A.offsets.size()))
+        {
+        if(A.offsets[n].offset != B.offsets[n].offset
+           || A.offsets[n].block != B.offsets[n].block) return false;
+        }
+    return true;
+    }
+
 template<typename T1, typename T2>
 void
 add(PlusEQ const& P,
@@ -520,31 +639,42 @@ add(PlusEQ const& P,
     {
     auto r = order(P.is1());
 
-    if(r==0)
+    if(r == 0 || (isTrivial(P.perm()) && sameBlocks(A,B)))
         {
-        auto dA = realData(A);
-        auto dB = realData(B);
-        daxpy_wrapper(dA.size(),P.alpha(),dB.data(),1,dA.data(),1);
-        return;
+        //Add the storage of B to that of A as one array
+        if constexpr(std::is_same<T1,T2>::value)
+            {
+            auto dA = realData(A);
+            auto dB = realData(B);
+            axpyKernel(dA.size(),P.alpha(),dB.data(),dA.data());
+            return;
+            }
+        else if constexpr(std::is_same<T1,Cplx>::value)
+            {
+            axpyKernel(A.size(),P.alpha(),B.data(),A.data());
+            return;
+            }
         }
 
-    auto Bblock = Block(r,0);
-    Range Arange,
-          Brange;
-
-    for(auto const& aio : A.offsets)
+    auto nblock = long(A.offsets.size());
+#pragma omp parallel for schedule(dynamic) if(nblock > 1 && long(A.size()) >= elementwiseParallelSize)
+    for(long n = 0; n < nblock; ++n)
         {
+        auto const& aio = A.offsets[n];
+        auto Bblock = Block(r,0);
         for(auto i : range(r))
             Bblock[i] = aio.block[P.perm().dest(i)];
 
         auto bblock = getBlock(B,P.is2(),Bblock);
         if(!bblock) continue;
 
+        Range Arange,
+              Brange;
         Arange.init(make_indexdim(P.is1(),aio.block));
         Brange.init(make_indexdim(P.is2(),Bblock));
         auto aref = makeTenRef(A.data(),aio.offset,A.size(),&Arange);
         auto bref = makeRef(bblock,&Brange);
-        transform(permute(bref,P.perm()),aref,Adder{P.alpha()});
+        parallelTransform(permute(bref,P.perm()),aref,Adder{P.alpha()});
         }
     }
 
@@ -668,6 +798,32 @@ template void doTask(PlusEQ const&, QDense<Cplx> const&, QDense<Real> const&, Ma
 template void doTask(PlusEQ const&, QDense<Cplx> const&, QDense<Cplx> const&, ManageStore&);
 
 
+//Whether storage d with indices is has the indices
+//(including arrow directions) and block layout 
+//(offsets, size) of a contraction result with
+//indices Nis
+template<typename V>
+bool
+sameLayout(IndexSet const& Nis,
+           BlockOffsets const& offsets,
+           size_t size,
+           IndexSet const& is,
+           QDense<V> const& d)
+    {
+    if(d.size() != size || d.offsets.size() != offsets.size()) return false;
+    if(order(is) != order(Nis)) return false;
+    for(auto n : range(order(is)))
+        {
+        if(is[n] != Nis[n] || dir(is[n]) != dir(Nis[n])) return false;
+        }
+    for(auto n : range(offsets))
+        {
+        if(d.offsets[n].offset != offsets[n].offset
+           || d.offsets[n].block != offsets[n].block) return false;
+        }
+    return true;
+    }
+
 template<typename VA, typename VB>
 void
 doTask(Contract& Con,
@@ -676,6 +832,7 @@ doTask(Contract& Con,
        ManageStore& m)
     {
     using VC = common_type<VA,VB>;
+    ContractProfiler::BlockScope profile_scope;
     Labels Lind,
            Rind;
 
@@ -686,28 +843,49 @@ doTask(Contract& Con,
     const bool sortResult = false;
     contractIS(Con.Lis,Lind,Con.Ris,Rind,Con.Nis,Cind,sortResult);
 
+    if(profile_scope.active())
+        {
+        auto dims = [](IndexSet const& is)
+            {
+            auto ds = std::vector<size_t>(order(is));
+            for(auto n : range(ds)) ds[n] = dim(is[n]);
+            return ds;
+            };
+        profile_scope.setSignature(contractSignature(Lind,dims(Con.Lis),
+                                                     Rind,dims(Con.Ris),
+                                                     Cind,dims(Con.Nis)));
+        }
+
     //Allocate storage for C
     auto [Coffsets,Csize,blockContractions] = getContractedOffsets(A,Con.Lis,B,Con.Ris,Con.Nis);
 
-    // Create QDense storage with uninitialized memory, faster than
-    // setting to zeros
-    auto nd = m.makeNewData<QDense<VC>>(undef,Coffsets,Csize);
-    auto& C = *nd;
+    //Write into the destination storage if it
+    //has the indices and block layout of the result
+    auto* dest = Con.into ? uniqueStorage<QDense<VC>>(*Con.into) : nullptr;
+    if(dest && !sameLayout(Con.Nis,Coffsets,Csize,*Con.intoIs,*dest)) dest = nullptr;
+
+    // Otherwise create QDense storage with uninitialized memory, 
+    // faster than setting to zeros
+    auto& C = dest ? *dest : *m.makeNewData<QDense<VC>>(undef,Coffsets,Csize);
+    auto alpha = dest ? Con.alpha : 1.;
 
     //Determines if the contraction in the list overwrites or
     //adds to the data. Initially, overwrite the data since the
-    //data starts uninitialized
-    auto betas = std::vector<Real>(C.offsets.size(),0.);
+    //data starts uninitialized (or scale it by beta when
+    //writing into existing storage)
+    auto betas = std::vector<Real>(C.offsets.size(),dest ? Con.beta : 0.);
 
     //Function to execute for each pair of
     //contracted blocks of A and B
     auto do_contract = 
-        [&Con,&Lind,&Rind,&Cind,&betas]
+        [&Con,&Lind,&Rind,&Cind,&betas,&profile_scope,alpha]
         (DataRange<const VA> ablock, Block const& Ablockind,
          DataRange<const VB> bblock, Block const& Bblockind,
          DataRange<VC>       cblock, Block const& Cblockind,
          int Cblockloc)
         {
+        //Blocks may be contracted on OpenMP worker threads
+        ContractProfiler::BlockScope::Worker profile_worker(profile_scope);
         Range Arange,
               Brange,
               Crange;
@@ -724,7 +902,7 @@ doTask(Contract& Con,
         auto cref = makeRef(cblock,&Crange);
 
         // cref += aref*bref or cref = aref*bref
-        contract(aref,Lind,bref,Rind,cref,Cind,1.,betas[Cblockloc]);
+        contract(aref,Lind,bref,Rind,cref,Cind,alpha,betas[Cblockloc]);
 
         // If the block had not been called, betas[Cblockloc] == 0
         // Set it to 1 after it has been called
@@ -736,6 +914,7 @@ doTask(Contract& Con,
                          C,Con.Nis,
                          blockContractions,
                          do_contract);
+    Con.wroteInto = (dest != nullptr);
 
 #ifdef USESCALE
     Con.scalefac = computeScalefac(C);
@@ -928,9 +1107,14 @@ doTask(RemoveQNs & R,
     auto *nd = m.makeNewData<Dense<V>>(dim(R.is),0);
     auto *pd = d.data();
     auto *pn = nd->data();
-    detail::GCounter C(r);
+    //Strides of the dense storage
+    auto nstride = std::vector<long>(r,1);
+    for(auto j : range(1,r)) nstride[j] = nstride[j-1]*dim(R.is[j-1]);
+    auto ext = std::vector<long>(r),
+         bstride = std::vector<long>(r);
     for(auto const& io : d.offsets)
         {
+        long nstart = 0;
         for(auto j : range(r))
             {
             long start = 0;
@@ -938,14 +1122,14 @@ doTask(RemoveQNs & R,
                 {
                 start += R.is[j].blocksize0(b);
                 }
-            C.setRange(j,start,start+R.is[j].blocksize0(io.block[j])-1);
-            }
-        //TODO: need to make a Range/TensorRef iterator
-        //to rewrite the following code more efficiently
-        for(; C.notDone(); ++C)
-            {
-            pn[offset(R.is,C.i)] = pd[io.offset+C.ind];
+            nstart += start*nstride[j];
+            ext[j] = R.is[j].blocksize0(io.block[j]);
+            bstride[j] = (j == 0) ? 1 : bstride[j-1]*ext[j-1];
             }
+        auto pb = pd+io.offset;
+        auto pnb = pn+nstart;
+        detail::stridedLoop(r,ext.data(),bstride.data(),nstride.data(),
+                            [pb,pnb](long ob, long on) { pnb[on] = pb[ob]; });
         }
     }
 template void doTask(RemoveQNs &, QDense<Real> const&, ManageStore &);
@@ -16,6 +16,8 @@
 #ifndef __ITENSOR_QDENSE_H
 #define __ITENSOR_QDENSE_H
 
+#include <memory>
+#include <unordered_map>
 #include <vector>
 #include "itensor/itdata/task_types.h"
 #include "itensor/itdata/itdata.h"
@@ -28,6 +30,58 @@ namespace itensor {
 template<typename T>
 class QDense;
 
+//
+// Lookup table from a block index to its position in
+// QDense::offsets. Blocks are numbered by their mixed-radix
+// linear id (radix of index j = number of blocks of index j);
+// the ids are stored in a flat table, or in a hash map if the
+// blocks are very sparse among all possible blocks.
+//
+class BlockLookup
+    {
+    std::vector<size_t> stride_;
+    size_t nblocks_ = 0;
+    std::vector<int> table_;
+    std::unordered_map<size_t,int> sparse_;
+
+    size_t
+    linearId(Block const& block) const
+        {
+        size_t id = 0;
+        for(decltype(stride_.size()) j = 0; j < stride_.size(); ++j) id += block[j]*stride_[j];
+        return id;
+        }
+    public:
+
+    BlockLookup(IndexSet const& is,
+                BlockOffsets const& offsets);
+
+    //Whether the table was built for offsets
+    //(checks the number of blocks and radices)
+    bool
+    valid(IndexSet const& is,
+          BlockOffsets const& offsets) const;
+
+    //Position of block in offsets, or -1 if absent
+    long
+    find(Block const& block) const;
+
+    //False if the number of possible blocks
+    //overflows the linear id
+    static bool
+    canIndex(IndexSet const& is);
+    };
+
+//Position of blockind in offsets, or -1 if absent.
+//Uses (and if needed builds) the table in lookup
+//when offsets has many blocks. Only a hit is found in
+//constant time, an absent block needs a binary search.
+long
+findBlockLoc(std::shared_ptr<const BlockLookup> & lookup,
+             IndexSet const& is,
+             BlockOffsets const& offsets,
+             Block const& blockind);
+
 using QDenseReal = QDense<Real>;
 using QDenseCplx = QDense<Cplx>;
 
@@ -53,6 +107,12 @@ class QDense
         //^ tensor data stored contiguously
     //////////////
 
+    private:
+    mutable std::shared_ptr<const BlockLookup> lookup_;
+        //^ built on first use by blockLoc;
+        //  reset by members changing offsets
+    public:
+
     QDense() { }
 
     QDense(IndexSet const& is, 
@@ -113,6 +173,27 @@ class QDense
 
     explicit operator bool() const { return !store.empty() && !offsets.empty(); }
 
+    //Position of block in offsets, or -1 if absent
+    long
+    blockLoc(IndexSet const& is,
+             Block const& block) const
+        {
+        return findBlockLoc(lookup_,is,offsets,block);
+        }
+
+    //Data offset of block, or -1 if absent
+    long
+    blockOffset(IndexSet const& is,
+                Block const& block) const
+        {
+        auto loc = blockLoc(is,block);
+        return loc >= 0 ? offsets[loc].offset : -1;
+        }
+
+    //Call after modifying offsets directly
+    void
+    resetBlockLookup() { std::atomic_store(&lookup_,std::shared_ptr<const BlockLookup>()); }
+
     value_type *
     data() { return store.data(); }
 
@@ -245,6 +326,7 @@ read(std::istream & s, QDense<T> & dat)
     {
     itensor::read(s,dat.offsets);
     itensor::read(s,dat.store);
+    dat.resetBlockLookup();
     }
 
 template<typename T>
@@ -254,6 +336,8 @@ swap(QDense<T> & d1,
     {
     d1.offsets.swap(d2.offsets);
     d1.store.swap(d2.store);
+    d1.resetBlockLookup();
+    d2.resetBlockLookup();
     }
 
 template<typename T>
@@ -481,9 +565,7 @@ getEltBlockOffset(IndexSet const& is,
         eoff += elt_subind*estr;
         estr *= I.blocksize0(block_subind);
         }
-    //Do a binary search (equal_range) to see
-    //if there is a block with block index "bind"
-    auto boff = offsetOf(offsets,block);
+    auto boff = blockOffset(is,block);
     if(boff >= 0)
         {
 #ifdef DEBUG
@@ -530,6 +612,7 @@ insertBlock(IndexSet const& is,
 
     // Insert the block and offset into the block-offsets list
     offsets.insert(offsets.begin()+insert_loc,make_blof(block,new_offset));
+    resetBlockLookup();
     return new_offset;
     }
 
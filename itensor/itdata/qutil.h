@@ -20,10 +20,60 @@
 #include <omp.h>
 #endif
 
+#include <unordered_map>
 #include "itensor/indexset.h"
+#include "itensor/tensor/lapack_wrap.h"
 
 namespace itensor {
 
+//
+// Hash of a block index (list of block numbers),
+// for bucketing blocks by their contracted sectors
+//
+struct BlockHash
+    {
+    size_t
+    operator()(Block const& b) const
+        {
+        //FNV-1a over the block numbers
+        size_t h = 14695981039346656037ul;
+        for(auto n : b)
+            {
+            h ^= static_cast<size_t>(n);
+            h *= 1099511628211ul;
+            }
+        return h;
+        }
+    };
+
+//Block numbers of block at the positions pos
+inline void
+subBlock(Block const& block,
+         std::vector<long> const& pos,
+         Block & res)
+    {
+    for(auto n : range(pos.size())) res[n] = block[pos[n]];
+    }
+
+//Indices into offsets, bucketed by the block
+//numbers at the positions pos (the contracted
+//sectors). Blocks in a bucket keep their order.
+template<typename BlockOffsetsT>
+std::unordered_map<Block,std::vector<size_t>,BlockHash>
+bucketBlocks(BlockOffsetsT const& offsets,
+             std::vector<long> const& pos)
+    {
+    auto buckets = std::unordered_map<Block,std::vector<size_t>,BlockHash>{};
+    buckets.reserve(offsets.size());
+    auto key = Block(pos.size(),0);
+    for(auto n : range(offsets.size()))
+        {
+        subBlock(offsets[n].block,pos,key);
+        buckets[key].push_back(n);
+        }
+    return buckets;
+    }
+
 //
 // Helper object for treating
 // QDense storage as a "tensor of tensors"
@@ -61,10 +111,12 @@ make_indexdim(IndexSet const& is, Indexable const& ind)
 template<typename T>
 int
 getBlockLoc(QDense<T> const& d,
+            IndexSet const& is,
             Block const& block_ind)
     {
-    auto loc = offsetOfLoc(d.offsets,block_ind);
-    return loc;
+    auto loc = d.blockLoc(is,block_ind);
+    if(loc >= 0) return loc;
+    return offsetOfLoc(d.offsets,block_ind);
     }
 
 template<typename BlockSparse>
@@ -79,9 +131,7 @@ getBlock(BlockSparse & d,
 #ifdef DEBUG
     if(is.order() != r) Error("Mismatched size of IndexSet and block_ind in getBlock");
 #endif
-    //Do binary search to see if there
-    //is a block with block index ii
-    auto boff = offsetOf(d.offsets,block_ind);
+    auto boff = d.blockOffset(is,block_ind);
     if(boff >= 0) return makeDataRange(d.data(),boff,d.size());
     using data_range_type = decltype(makeDataRange(d.data(),d.size()));
     return data_range_type{};
@@ -129,6 +179,21 @@ getContractedOffsets(BlockSparseA const& A,
             }
         }
 
+    //Positions of the contracted indices in A and
+    //(in the same order) in B
+    auto Acont = std::vector<long>{};
+    auto Bcont = std::vector<long>{};
+    for(auto iA : range(rA))
+        {
+        if(AtoB[iA] == -1) continue;
+        Acont.push_back(iA);
+        Bcont.push_back(AtoB[iA]);
+        }
+
+    //Blocks of B bucketed by their contracted sectors, so that each
+    //block of A only visits the blocks of B it contracts with
+    auto Bbuckets = bucketBlocks(B.offsets,Bcont);
+
     // Store pairs of unordered block numbers and their sizes,
     // to be ordered later
     using BlockContractions = std::vector<std::tuple<Block,Block,Block>>;
@@ -146,6 +211,7 @@ getContractedOffsets(BlockSparseA const& A,
 #pragma omp parallel
     {
     auto Cblockind = Block(rC,0);
+    auto key = Block(Acont.size(),0);
 
 #ifdef ITENSOR_USE_OMP
     int thread_num = omp_get_thread_num();
@@ -160,21 +226,14 @@ getContractedOffsets(BlockSparseA const& A,
         for(auto iA : range(rA))
             if(AtoC[iA] != -1) Cblockind[AtoC[iA]] = aio.block[iA];
 
+        subBlock(aio.block,Acont,key);
+        auto match = Bbuckets.find(key);
+        if(match == Bbuckets.end()) continue;
+
         //Loop over blocks of B which contract with current block of A
-        for(auto const& bio : B.offsets)
+        for(auto nb : match->second)
             {
-            auto do_blocks_contract = true;
-            for(auto iA : range(rA))
-                {
-                auto iB = AtoB[iA];
-                if(AtoB[iA] != -1)
-                    if(aio.block[iA] != bio.block[iB])
-                        {
-                        do_blocks_contract = false;
-                        break;
-                        }
-                }
-            if(!do_blocks_contract) continue;
+            auto const& bio = B.offsets[nb];
 
             //Finish making Cblockind
             for(auto iB : range(rB))
@@ -199,7 +258,7 @@ getContractedOffsets(BlockSparseA const& A,
 #else
             Cblocksizes.push_back(make_blof(Cblockind,blockDim));
 #endif
-            } //for B.offsets
+            } //for matching B blocks
         } //for A.offsets
     }  // omp parallel
 
@@ -260,7 +319,7 @@ _loopContractedBlocks(QDense<TA> const& A,
         auto ablock = getBlock(A,Ais,Ablockind);
         auto bblock = getBlock(B,Bis,Bblockind);
         auto cblock = getBlock(C,Cis,Cblockind);
-        auto Cblockloc = getBlockLoc(C,Cblockind);
+        auto Cblockloc = getBlockLoc(C,Cis,Cblockind);
         callback(ablock,Ablockind,
                  bblock,Bblockind,
                  cblock,Cblockind,
@@ -327,9 +386,11 @@ _loopContractedBlocksOMP(QDense<TA> const& A,
     if(ncontractions != n) Error("Wrong number of contractions in QDense contraction");
 #endif
 
+    auto single = gemmSinglePrecision();
     #pragma omp parallel for schedule(dynamic)
     for(decltype(nnzblocksC) i = 0; i < nnzblocksC; i++)
       {
+      auto gemm_mode = GemmPrecisionScope(single);
       // Contractions that have the same output block
       // location in C are put in the same thread to
       // avoid race conditions
@@ -339,7 +400,7 @@ _loopContractedBlocksOMP(QDense<TA> const& A,
         auto ablock = getBlock(A,Ais,Ablockind);
         auto bblock = getBlock(B,Bis,Bblockind);
         auto cblock = getBlock(C,Cis,Cblockind);
-        auto Cblockloc = getBlockLoc(C,Cblockind);
+        auto Cblockloc = getBlockLoc(C,Cis,Cblockind);
         callback(ablock,Ablockind,
                  bblock,Bblockind,
                  cblock,Cblockind,
@@ -417,40 +478,63 @@ loopContractedBlocks(TA const& A,
             }
         }
 
+    auto Acont = std::vector<long>{};
+    for(auto iA : range(rA))
+        {
+        if(AtoB[iA] != -1) Acont.push_back(iA);
+        }
+
+    //Non-zero blocks of B found for each setting of the
+    //contracted sectors, so the search over the blocks
+    //of B is only done once per distinct setting
+    auto Bblocks = std::unordered_map<Block,std::vector<Block>,BlockHash>{};
+    auto key = Block(Acont.size(),0);
+
     auto couB = detail::GCounter(rB);
     auto Bblockind = Block(rB,0);
     auto Cblockind = Block(rC,0);
     //Loop over blocks of A (labeled by elements of A.offsets)
     for(auto const& aio : A.offsets)
         {
-        //Reset couB to run over indices of B (at first)
-        couB.reset();
-        for(auto iB : range(rB))
+        for(auto iA : range(rA))
             {
-            couB.setRange(iB,0,Bis[iB].nblock()-1);
+            //Begin computing elements of Cblock(=destination of this block-block contraction)
+            if(AtoC[iA] != -1) Cblockind[AtoC[iA]] = aio.block[iA];
             }
-        for(auto iA : range(rA))
+
+        subBlock(aio.block,Acont,key);
+        auto match = Bblocks.find(key);
+        if(match == Bblocks.end())
             {
-            auto ival = aio.block[iA];
+            match = Bblocks.emplace(key,std::vector<Block>{}).first;
+            //Reset couB to run over indices of B (at first)
+            couB.reset();
+            for(auto iB : range(rB))
+                {
+                couB.setRange(iB,0,Bis[iB].nblock()-1);
+                }
             //Restrict couB to be fixed for indices of B contracted with A
-            if(AtoB[iA] != -1) couB.setRange(AtoB[iA],ival,ival);
-            //Begin computing elements of Cblock(=destination of this block-block contraction)
-            if(AtoC[iA] != -1) Cblockind[AtoC[iA]] = ival;
+            for(auto iA : range(rA))
+                {
+                if(AtoB[iA] != -1) couB.setRange(AtoB[iA],aio.block[iA],aio.block[iA]);
+                }
+            //Check whether B contains non-zero block for each setting of couB
+            for(;couB.notDone(); ++couB)
+                {
+                for(auto iB : range(rB)) Bblockind[iB] = couB.i[iB];
+                if(getBlock(B,Bis,Bblockind)) match->second.push_back(Bblockind);
+                }
             }
+
         //Loop over blocks of B which contract with current block of A
-        for(;couB.notDone(); ++couB)
+        for(auto const& Bb : match->second)
             {
-            //Check whether B contains non-zero block for this setting of couB
-            //TODO: check whether block is present by storing all blocks
-            //      but most have null pointers to data
-            //Finish making Cblockind and Bblockind
+            //Finish making Cblockind
             for(auto iB : range(rB))
                 {
-                if(BtoC[iB] != -1) Cblockind[BtoC[iB]] = couB.i[iB];
-                Bblockind[iB] = couB.i[iB];
+                if(BtoC[iB] != -1) Cblockind[BtoC[iB]] = Bb[iB];
                 }
-            auto bblock = getBlock(B,Bis,Bblockind);
-            if(!bblock) continue;
+            auto bblock = getBlock(B,Bis,Bb);
 
             auto cblock = getBlock(C,Cis,Cblockind);
             assert(cblock);
@@ -458,9 +542,9 @@ loopContractedBlocks(TA const& A,
             auto ablock = makeDataRange(A.data(),aio.offset,A.size());
 
             callback(ablock,aio.block,
-                     bblock,Bblockind,
+                     bblock,Bb,
                      cblock,Cblockind);
-            } //for couB
+            } //for matching B blocks
         } //for A.offsets
     }
 
@@ -23,6 +23,8 @@
 
 namespace itensor {
 
+struct ITData;
+
 //
 // Task Types
 // 
@@ -392,6 +394,16 @@ struct Contract
     IndexSet Nis; //new IndexSet
     Real scalefac = NAN;
     bool needresult = false;
+    //Optional destination (see contract(A,B,C,alpha,beta)):
+    //Dense and QDense contractions whose result has the
+    //index set *intoIs and the storage type and layout of
+    //*into set *into = alpha*L*R + beta*(*into) in place
+    //and set wroteInto, instead of making new storage
+    std::shared_ptr<ITData>* into = nullptr;
+    IndexSet const* intoIs = nullptr;
+    Real alpha = 1.,
+         beta = 0.;
+    bool wroteInto = false;
 
     Contract(const IndexSet& Lis_,
              const IndexSet& Ris_)
@@ -416,7 +428,12 @@ struct Contract
         Ris(other.Ris),
         Nis(std::move(other.Nis)),
         scalefac(other.scalefac),
-        needresult(other.needresult)
+        needresult(other.needresult),
+        into(other.into),
+        intoIs(other.intoIs),
+        alpha(other.alpha),
+        beta(other.beta),
+        wroteInto(other.wroteInto)
         { }
 
     };
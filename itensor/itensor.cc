@@ -939,6 +939,8 @@ operator*=(ITensor const& R)
 
     if(!L || !R) Error("Default constructed ITensor in product");
 
+    TRACE_SCOPE("contract");
+
     if(L.order() == 0)
         {
         auto z = L.eltC();
@@ -980,6 +982,70 @@ operator*=(ITensor const& R)
     return L;
     }
 
+void
+contract(ITensor const& A,
+         ITensor const& B,
+         ITensor & C,
+         Real alpha,
+         Real beta)
+    {
+    if(!A || !B) Error("Default constructed ITensor in product");
+
+    //C can hold the result if its indices
+    //are exactly those not shared by A and B
+    auto fits = C && C.store() && order(A) > 0 && order(B) > 0
+                && hasQNs(A) == hasQNs(B) && hasQNs(C) == hasQNs(A);
+#ifdef USESCALE
+    fits = false;
+#endif
+    if(fits)
+        {
+        auto ncommon = 0;
+        for(auto& i : A.inds()) if(hasIndex(B.inds(),i)) ++ncommon;
+        fits = (order(C) == order(A)+order(B)-2*ncommon);
+        for(auto& i : C.inds())
+            {
+            if(!fits) break;
+            fits = (hasIndex(A.inds(),i) != hasIndex(B.inds(),i));
+            }
+        }
+
+    auto P = ITensor{};
+    if(fits)
+        {
+        TRACE_SCOPE("contract");
+        if(Global::checkArrows()) detail::checkArrows(A.inds(),B.inds());
+        auto L = A;
+        auto R = B;
+        auto Con = Contract{L.inds(),R.inds()};
+        Con.into = &C.store();
+        Con.intoIs = &C.inds();
+        Con.alpha = alpha;
+        Con.beta = beta;
+        auto res = doTask(std::move(Con),L.store(),R.store());
+        if(res.wroteInto) return;
+#ifdef DEBUG
+        checkIndexSet(res.Nis);
+#endif
+        P = ITensor(std::move(res.Nis),std::move(L.store()));
+        }
+    else
+        {
+        P = A*B;
+        }
+
+    if(alpha != 1.) P *= alpha;
+    if(beta == 0. || !C)
+        {
+        C = std::move(P);
+        }
+    else
+        {
+        C *= beta;
+        C += P;
+        }
+    }
+
 #ifndef USESCALE
 
 //for Diag and QDiag
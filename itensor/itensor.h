@@ -543,6 +543,24 @@ ITensor
 operator*(ITensor T, Complex fac);
 ITensor
 operator*(Complex fac, ITensor T);
+
+//
+// Contract A and B, setting C = alpha*A*B + beta*C.
+// If C holds unshared Dense or QDense storage with
+// the layout of the result (for QDense the indices
+// must also be in the order A*B would give them),
+// the result is written into that storage 
+// without allocating; otherwise the product is
+// made in new storage and C is updated using it.
+// When beta == 0 any C may be passed, including a
+// default-constructed one.
+//
+void
+contract(ITensor const& A,
+         ITensor const& B,
+         ITensor & C,
+         Real alpha = 1.,
+         Real beta = 0.);
 ITensor
 operator/(ITensor T, Real fac);
 ITensor
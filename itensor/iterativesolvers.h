@@ -22,6 +22,32 @@
 
 namespace itensor {
 
+//
+// Options recognized by davidson, read once from Args:
+//   MaxIter (default 2), ErrGoal (1E-14),
+//   DebugLevel (-1), MinIter (1)
+// Loops calling davidson many times (such as DMRG sweeps)
+// can construct a DavidsonOptions once and pass it instead
+// of Args.
+//
+struct DavidsonOptions
+    {
+    size_t maxiter = 2;
+    Real errgoal = 1E-14;
+    int debug_level = -1;
+    size_t miniter = 1;
+
+    DavidsonOptions() { }
+
+    explicit
+    DavidsonOptions(Args const& args)
+      : maxiter(args.getSizeT("MaxIter",2)),
+        errgoal(args.getReal("ErrGoal",1E-14)),
+        debug_level(args.getInt("DebugLevel",-1)),
+        miniter(args.getSizeT("MinIter",1))
+        { }
+    };
+
 //
 // Use the Davidson algorithm to find the 
 // eigenvector of the Hermitian matrix A with minimal eigenvalue.
@@ -49,6 +75,18 @@ davidson(BigMatrixT const& A,
          std::vector<ITensor>& phi,
          Args const& args = Args::global());
 
+template <class BigMatrixT>
+Real 
+davidson(BigMatrixT const& A, 
+         ITensor& phi,
+         DavidsonOptions const& opts);
+
+template <class BigMatrixT>
+std::vector<Real>
+davidson(BigMatrixT const& A, 
+         std::vector<ITensor>& phi,
+         DavidsonOptions const& opts);
+
 //
 // Use GMRES to iteratively solve A x = b for x.
 // (BigMatrixT objects must implement the methods product and size.)
@@ -89,9 +127,18 @@ davidson(BigMatrixT const& A,
          ITensor& phi,
          Args const& args)
     {
+    return davidson(A,phi,DavidsonOptions(args));
+    }
+
+template <class BigMatrixT>
+Real
+davidson(BigMatrixT const& A, 
+         ITensor& phi,
+         DavidsonOptions const& opts)
+    {
     auto v = std::vector<ITensor>(1);
     v.front() = phi;
-    auto eigs = davidson(A,v,args);
+    auto eigs = davidson(A,v,opts);
     phi = v.front();
     return eigs.front();
     }
@@ -102,10 +149,21 @@ davidson(BigMatrixT const& A,
          std::vector<ITensor>& phi,
          Args const& args)
     {
-    auto maxiter_ = args.getSizeT("MaxIter",2);
-    auto errgoal_ = args.getReal("ErrGoal",1E-14);
-    auto debug_level_ = args.getInt("DebugLevel",-1);
-    auto miniter_ = args.getSizeT("MinIter",1);
+    return davidson(A,phi,DavidsonOptions(args));
+    }
+
+template <class BigMatrixT>
+std::vector<Real>
+davidson(BigMatrixT const& A, 
+         std::vector<ITensor>& phi,
+         DavidsonOptions const& opts)
+    {
+    TRACE_SCOPE("davidson");
+
+    auto maxiter_ = opts.maxiter;
+    auto errgoal_ = opts.errgoal;
+    auto debug_level_ = opts.debug_level;
+    auto miniter_ = opts.miniter;
 
     Real Approx0 = 1E-12;
 
@@ -162,9 +220,10 @@ davidson(BigMatrixT const& A,
     auto eigs = std::vector<Real>(nget,NAN);
 
     V[0] = phi.front();
-TIMER_START(31);
+    {
+    TRACE_SCOPE("product");
     A.product(V[0],AV[0]);
-TIMER_STOP(31);
+    }
 
     auto initEn = real(eltC((dag(V[0])*AV[0])));
 
@@ -380,9 +439,10 @@ TIMER_STOP(31);
         //Step G of Davidson (1975)
         //Expand AV and M
         //for next step
-TIMER_START(31);
+        {
+        TRACE_SCOPE("product");
         A.product(V[ni],AV[ni]);
-TIMER_STOP(31);
+        }
 
         //Step H of Davidson (1975)
         //Add new row and column to M
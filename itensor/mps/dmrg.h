@@ -341,6 +341,8 @@ DMRGWorker(MPS & psi,
            DMRGObserver & obs,
            Args args)
     {
+    TRACE_SCOPE("dmrg");
+
     if( args.defined("WriteM") )
       {
       if( args.defined("WriteDim") )
@@ -375,10 +377,17 @@ DMRGWorker(MPS & psi,
 
     args.add("DebugLevel",debug_level);
     args.add("DoNormalize",true);
+
+    //The first "SinglePrecisionSweeps" sweeps do their matrix 
+    //multiplications in single precision (see gemmSinglePrecision);
+    //the previous mode of this thread is restored on return
+    const int nsingle = args.getInt("SinglePrecisionSweeps",0);
+    auto gemm_mode = GemmPrecisionScope(gemmSinglePrecision());
     
     for(int sw = 1; sw <= sweeps.nsweep(); ++sw)
         {
         cpu_time sw_time;
+        if(nsingle > 0) gemmSinglePrecision(sw <= nsingle);
         args.add("Sweep",sw);
         args.add("NSweep",sweeps.nsweep());
         args.add("Cutoff",sweeps.cutoff(sw));
@@ -386,6 +395,10 @@ DMRGWorker(MPS & psi,
         args.add("MaxDim",sweeps.maxdim(sw));
         args.add("Noise",sweeps.noise(sw));
         args.add("MaxIter",sweeps.niter(sw));
+        //Parse the eigensolver and truncation options
+        //once per sweep rather than at every bond
+        auto dopts = DavidsonOptions(args);
+        auto topts = svdBondTruncateOptions(args);
 
         if(!PH.doWrite()
            && args.defined("WriteDim")
@@ -408,21 +421,20 @@ DMRGWorker(MPS & psi,
                 printfln("Sweep=%d, HS=%d, Bond=%d/%d",sw,ha,b,(N-1));
                 }
 
-TIMER_START(1);
+            {
+            TRACE_SCOPE("position");
             PH.position(b,psi);
-TIMER_STOP(1);
+            }
 
-TIMER_START(2);
             auto phi = psi(b)*psi(b+1);
-TIMER_STOP(2);
 
-TIMER_START(3);
-            energy = davidson(PH,phi,args);
-TIMER_STOP(3);
+            energy = davidson(PH,phi,dopts);
             
-TIMER_START(4);
-            auto spec = psi.svdBond(b,phi,(ha==1?Fromleft:Fromright),PH,args);
-TIMER_STOP(4);
+            auto spec = Spectrum();
+            {
+            TRACE_SCOPE("svdBond");
+            spec = psi.svdBond(b,phi,(ha==1?Fromleft:Fromright),PH,topts,args);
+            }
 
             if(!quiet)
                 { 
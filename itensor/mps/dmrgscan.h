@@ -0,0 +1,221 @@
+//
+// Copyright 2018 The Simons Foundation, Inc. - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef __ITENSOR_DMRGSCAN_H
+#define __ITENSOR_DMRGSCAN_H
+
+#ifdef ITENSOR_USE_OMP
+#include <omp.h>
+#endif
+
+#include <cmath>
+#include <exception>
+#include <mutex>
+#include "itensor/mps/dmrg.h"
+#include "itensor/mps/autompo.h"
+
+namespace itensor {
+
+//
+// One DMRG calculation of a parameter scan.
+//
+// The Hamiltonian is H, or if H is empty it is
+// made from ampo by toMPO when the job starts.
+// params is the point in parameter space of the
+// job, used to pick neighbors for warm starts.
+//
+struct DMRGJob
+    {
+    MPO H;
+    AutoMPO ampo;
+    MPS psi0;
+    Sweeps sweeps;
+    //Sweeps to use instead of sweeps when the job
+    //is warm started (if nsweep() > 0)
+    Sweeps warm_sweeps;
+    std::vector<Real> params;
+
+    DMRGJob() { }
+
+    DMRGJob(MPO const& H_,
+            MPS const& psi0_,
+            Sweeps const& sweeps_,
+            std::vector<Real> const& params_ = {})
+      : H(H_),
+        psi0(psi0_),
+        sweeps(sweeps_),
+        params(params_)
+        { }
+
+    DMRGJob(AutoMPO const& ampo_,
+            MPS const& psi0_,
+            Sweeps const& sweeps_,
+            std::vector<Real> const& params_ = {})
+      : ampo(ampo_),
+        psi0(psi0_),
+        sweeps(sweeps_),
+        params(params_)
+        { }
+    };
+
+struct DMRGResult
+    {
+    Real energy = 0.;
+    MPS psi;
+    //Job whose converged MPS was the starting
+    //state of this one, or -1 if psi0 was used
+    int warm_start = -1;
+    };
+
+//
+// Run the DMRG calculations of a list of jobs within
+// one process. When ITensor is compiled with OpenMP,
+// up to "NumThreads" jobs run at the same time, each
+// on one thread. Jobs start in the order given, so
+// scanning along a parameter gives warm starts from the
+// previous points. Jobs made from the same SiteSet share
+// its cache of operators.
+//
+// Named arguments recognized:
+//  "NumThreads" - number of jobs to run concurrently
+//                 (default: the OpenMP thread count)
+//  "WarmStart" - if true, start each job from the result
+//                of the nearest (in params) finished job
+//                with the same site indices and total QN
+//                (default false)
+//  "Verbose" - print a line as each job finishes
+//              (default false)
+// Other arguments are passed to dmrg, with "Silent"
+// defaulting to true.
+//
+std::vector<DMRGResult>
+dmrgScan(std::vector<DMRGJob> const& jobs,
+         Args const& args = Args::global());
+
+
+//
+// Implementation
+//
+
+namespace detail {
+
+//Whether the converged MPS psi can
+//be the starting state for psi0
+bool inline
+canWarmStart(MPS const& psi,
+             MPS const& psi0)
+    {
+    if(length(psi) != length(psi0)) return false;
+    for(auto j : range1(length(psi0)))
+        {
+        if(siteIndex(psi,j) != siteIndex(psi0,j)) return false;
+        }
+    if(hasQNs(psi0) && totalQN(psi) != totalQN(psi0)) return false;
+    return true;
+    }
+
+Real inline
+paramDistance(std::vector<Real> const& a,
+              std::vector<Real> const& b)
+    {
+    auto d = 0.;
+    for(auto n : range(a.size())) d += (a[n]-b[n])*(a[n]-b[n]);
+    return std::sqrt(d);
+    }
+
+} //namespace detail
+
+std::vector<DMRGResult> inline
+dmrgScan(std::vector<DMRGJob> const& jobs,
+         Args const& args)
+    {
+    auto njob = long(jobs.size());
+    auto warm = args.getBool("WarmStart",false);
+    auto verbose = args.getBool("Verbose",false);
+    auto nthreads = args.getInt("NumThreads",0);
+#ifdef ITENSOR_USE_OMP
+    if(nthreads <= 0) nthreads = omp_get_max_threads();
+#endif
+    if(nthreads <= 0) nthreads = 1;
+    auto dargs = args;
+    if(not args.defined("Silent")) dargs.add("Silent",true);
+
+    auto res = std::vector<DMRGResult>(njob);
+    auto done = std::vector<bool>(njob,false);
+    auto errors = std::vector<std::exception_ptr>(njob);
+    std::mutex mutex;
+
+#pragma omp parallel for schedule(dynamic,1) num_threads(nthreads) if(nthreads != 1 && njob > 1)
+    for(long n = 0; n < njob; ++n)
+        {
+        try
+            {
+            auto& job = jobs[n];
+            auto& r = res[n];
+            r.psi = job.psi0;
+            auto const* sweeps = &job.sweeps;
+            if(warm && not job.params.empty())
+                {
+                std::lock_guard<std::mutex> lock(mutex);
+                auto best = -1.;
+                for(auto m : range(njob))
+                    {
+                    if(not done[m] || jobs[m].params.size() != job.params.size()) continue;
+                    if(not detail::canWarmStart(res[m].psi,job.psi0)) continue;
+                    auto d = detail::paramDistance(jobs[m].params,job.params);
+                    if(r.warm_start < 0 || d < best)
+                        {
+                        best = d;
+                        r.warm_start = m;
+                        }
+                    }
+                if(r.warm_start >= 0) r.psi = res[r.warm_start].psi;
+                }
+            if(r.warm_start >= 0 && job.warm_sweeps.nsweep() > 0) sweeps = &job.warm_sweeps;
+
+            if(length(job.H) > 0)
+                {
+                r.energy = dmrg(r.psi,job.H,*sweeps,dargs);
+                }
+            else
+                {
+                auto H = toMPO(job.ampo);
+                r.energy = dmrg(r.psi,H,*sweeps,dargs);
+                }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            done[n] = true;
+            if(verbose)
+                {
+                printfln("Job %d done, energy = %.12f, max dim = %d%s",n,r.energy,maxLinkDim(r.psi),
+                         r.warm_start >= 0 ? format(" (started from job %d)",r.warm_start) : "");
+                }
+            }
+        catch(...)
+            {
+            errors[n] = std::current_exception();
+            }
+        }
+
+    for(auto& e : errors)
+        {
+        if(e) std::rethrow_exception(e);
+        }
+    return res;
+    }
+
+} //namespace itensor
+
+#endif
@@ -0,0 +1,435 @@
+//
+// Copyright 2018 The Simons Foundation, Inc. - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef __ITENSOR_LATTICE_ORDERING_H_
+#define __ITENSOR_LATTICE_ORDERING_H_
+
+#include <algorithm>
+#include <deque>
+#include "itensor/mps/lattice/latticebond.h"
+#include "itensor/mps/autompo.h"
+#include "itensor/tensor/algs.h"
+
+namespace itensor {
+
+//
+// A relabelling of the sites 1,2,...,N of a lattice.
+// Site n of the original labelling is placed at
+// position newSite(n) of the new ordering, and
+// oldSite(j) is the original label of the site at
+// position j.
+//
+// The ordering of the sites along an MPS determines
+// how many bonds (terms of the Hamiltonian) cross each
+// cut, which bounds the MPO bond dimension and typically
+// controls the entanglement the MPS has to carry.
+// Use siteOrder(G) to find a good ordering, then
+//
+//   auto ord = siteOrder(G);
+//   auto Gnew = relabel(G,ord);      //build H from Gnew, or:
+//   auto Hnew = toMPO(relabel(ampo,ord));
+//   ...
+//   auto sz = toOriginalOrder(ord,measured_sz);
+//
+class SiteOrder
+    {
+    std::vector<int> new_, //new_[n-1] = position of original site n
+                     old_; //old_[j-1] = original site at position j
+    public:
+
+    SiteOrder() { }
+
+    //Identity ordering of N sites
+    explicit
+    SiteOrder(int N);
+
+    //order[j-1] is the original label of
+    //the site to be placed at position j
+    explicit
+    SiteOrder(std::vector<int> const& order);
+
+    int
+    length() const { return old_.size(); }
+
+    int
+    newSite(int n) const { return new_.at(n-1); }
+
+    int
+    oldSite(int j) const { return old_.at(j-1); }
+
+    std::vector<int> const&
+    order() const { return old_; }
+    };
+
+inline SiteOrder::
+SiteOrder(int N)
+  : new_(N),
+    old_(N)
+    {
+    for(auto n : range(N)) new_[n] = old_[n] = 1+n;
+    }
+
+inline SiteOrder::
+SiteOrder(std::vector<int> const& order)
+  : new_(order.size(),0),
+    old_(order)
+    {
+    auto N = int(order.size());
+    for(auto j : range1(N))
+        {
+        auto n = old_[j-1];
+        if(n < 1 || n > N || new_[n-1] != 0)
+            {
+            Error("SiteOrder: order must be a permutation of 1,2,...,N");
+            }
+        new_[n-1] = j;
+        }
+    }
+
+std::ostream inline&
+operator<<(std::ostream & s, SiteOrder const& ord)
+    {
+    for(auto j : range1(ord.length())) s << format("%d -> %d\n",ord.oldSite(j),j);
+    return s;
+    }
+
+//
+// Number of sites of a LatticeGraph
+// (largest site label appearing in a bond)
+//
+int inline
+numSites(LatticeGraph const& G)
+    {
+    int N = 0;
+    for(auto& b : G) N = std::max(N,std::max(b.s1,b.s2));
+    return N;
+    }
+
+//
+// Graph with a bond between every pair of
+// sites acted on by the same term of an AutoMPO
+//
+LatticeGraph inline
+interactionGraph(AutoMPO const& ampo)
+    {
+    auto bonds = std::set<std::pair<int,int>>{};
+    for(auto& t : ampo.terms())
+    for(auto& op1 : t.ops)
+    for(auto& op2 : t.ops)
+        {
+        if(op1.i < op2.i) bonds.emplace(op1.i,op2.i);
+        }
+    auto G = LatticeGraph{};
+    G.reserve(bonds.size());
+    for(auto& b : bonds) G.emplace_back(b.first,b.second);
+    return G;
+    }
+
+//
+// Number of bonds of G crossing the cut between
+// positions j and j+1 of the ordering, for j = 1,...,N-1
+// (returned with 0-based index j-1)
+//
+std::vector<int> inline
+cutSizes(LatticeGraph const& G,
+         SiteOrder const& ord)
+    {
+    auto N = ord.length();
+    auto cuts = std::vector<int>(std::max(N-1,0),0);
+    for(auto& b : G)
+        {
+        auto j1 = ord.newSite(b.s1),
+             j2 = ord.newSite(b.s2);
+        if(j1 > j2) std::swap(j1,j2);
+        for(auto j = j1; j < j2; ++j) cuts[j-1] += 1;
+        }
+    return cuts;
+    }
+
+//
+// Largest number of bonds crossing any cut.
+// For a Hamiltonian with one term per bond this
+// bounds the MPO bond dimension (up to the
+// dimension of the site operators).
+//
+int inline
+cutWidth(LatticeGraph const& G,
+         SiteOrder const& ord)
+    {
+    auto cuts = cutSizes(G,ord);
+    return cuts.empty() ? 0 : *std::max_element(cuts.begin(),cuts.end());
+    }
+
+namespace detail {
+
+//Adjacency lists of G, 0-indexed, with repeated bonds removed
+inline std::vector<std::vector<int>>
+adjacency(LatticeGraph const& G, int N)
+    {
+    auto adj = std::vector<std::vector<int>>(N);
+    for(auto& b : G)
+        {
+        if(b.s1 == b.s2) continue;
+        adj.at(b.s1-1).push_back(b.s2-1);
+        adj.at(b.s2-1).push_back(b.s1-1);
+        }
+    for(auto& a : adj)
+        {
+        std::sort(a.begin(),a.end());
+        a.erase(std::unique(a.begin(),a.end()),a.end());
+        }
+    return adj;
+    }
+
+//Orderings are compared by their largest cut,
+//then by the sum of all cuts
+inline std::pair<long,long>
+orderCost(LatticeGraph const& G, SiteOrder const& ord)
+    {
+    auto cuts = cutSizes(G,ord);
+    long max = 0, sum = 0;
+    for(auto c : cuts)
+        {
+        max = std::max(max,long(c));
+        sum += c;
+        }
+    return std::make_pair(max,sum);
+    }
+
+//Reverse Cuthill-McKee ordering, starting the first
+//connected component from site "start" (0-indexed)
+//and later components from a site of lowest degree
+inline SiteOrder
+reverseCuthillMcKee(std::vector<std::vector<int>> const& adj,
+                    int start)
+    {
+    auto N = int(adj.size());
+    auto deg = [&adj](int n) { return adj[n].size(); };
+    auto visited = std::vector<bool>(N,false);
+    auto order = std::vector<int>{};
+    order.reserve(N);
+    auto next = std::deque<int>{};
+    auto nbrs = std::vector<int>{};
+    while(int(order.size()) < N)
+        {
+        if(order.empty())
+            {
+            next.push_back(start);
+            }
+        else
+            {
+            auto s = -1;
+            for(auto n : range(N))
+                {
+                if(!visited[n] && (s < 0 || deg(n) < deg(s))) s = n;
+                }
+            next.push_back(s);
+            }
+        visited[next.front()] = true;
+        while(!next.empty())
+            {
+            auto n = next.front();
+            next.pop_front();
+            order.push_back(1+n);
+            nbrs.clear();
+            for(auto m : adj[n]) if(!visited[m]) nbrs.push_back(m);
+            std::stable_sort(nbrs.begin(),nbrs.end(),
+                             [&deg](int a, int b) { return deg(a) < deg(b); });
+            for(auto m : nbrs)
+                {
+                visited[m] = true;
+                next.push_back(m);
+                }
+            }
+        }
+    std::reverse(order.begin(),order.end());
+    return SiteOrder(order);
+    }
+
+//Order sites by their component of the Fiedler vector:
+//the eigenvector of the graph Laplacian with the
+//second-smallest eigenvalue
+inline SiteOrder
+fiedlerOrder(std::vector<std::vector<int>> const& adj)
+    {
+    auto N = int(adj.size());
+    if(N < 3) return SiteOrder(N);
+    auto L = Matrix(N,N);
+    for(auto n : range(N))
+        {
+        L(n,n) = adj[n].size();
+        for(auto m : adj[n]) L(n,m) = -1.;
+        }
+    auto U = Matrix{};
+    auto d = Vector{};
+    diagHermitian(L,U,d);
+    //Eigenvalues are in decreasing order
+    auto order = std::vector<int>(N);
+    for(auto n : range(N)) order[n] = 1+n;
+    std::stable_sort(order.begin(),order.end(),
+                     [&U,N](int a, int b) { return U(a-1,N-2) < U(b-1,N-2); });
+    return SiteOrder(order);
+    }
+
+} //namespace detail
+
+//
+// Find an ordering of the sites of the lattice
+// G which makes the number of bonds crossing
+// any cut (see cutWidth) small.
+//
+// Arguments recognized:
+// o "Method":
+//   - (Default) "Best" - try each of the methods below
+//     and keep the ordering with the smallest cutWidth
+//     (then smallest sum of cut sizes); the original
+//     ordering is kept unless one of them is better
+//   - "CuthillMcKee" - reverse Cuthill-McKee (breadth-first)
+//     ordering; every site of lowest degree is tried as
+//     starting site, keeping the best result
+//   - "Fiedler" - order by the components of the Fiedler
+//     vector of the graph Laplacian (spectral ordering)
+// o "N" - number of sites (default is the largest site
+//   number appearing in G)
+//
+SiteOrder inline
+siteOrder(LatticeGraph const& G,
+          Args const& args = Args::global())
+    {
+    auto N = std::max(int(args.getInt("N",0)),numSites(G));
+    auto method = args.getString("Method","Best");
+    if(method != "Best" && method != "CuthillMcKee" && method != "Fiedler")
+        {
+        Error("siteOrder: unrecognized Method " + method);
+        }
+
+    auto adj = detail::adjacency(G,N);
+    auto best = SiteOrder(N);
+    auto best_cost = detail::orderCost(G,best);
+    auto first = true;
+    auto consider = [&](SiteOrder const& ord)
+        {
+        auto cost = detail::orderCost(G,ord);
+        if(cost < best_cost || (first && method != "Best"))
+            {
+            best = ord;
+            best_cost = cost;
+            }
+        first = false;
+        };
+
+    if(method != "Fiedler" && N > 0)
+        {
+        auto mindeg = adj[0].size();
+        for(auto& a : adj) mindeg = std::min(mindeg,a.size());
+        for(auto n : range(N))
+            {
+            if(adj[n].size() == mindeg) consider(detail::reverseCuthillMcKee(adj,n));
+            }
+        }
+    if(method != "CuthillMcKee")
+        {
+        consider(detail::fiedlerOrder(adj));
+        }
+    return best;
+    }
+
+//
+// Relabel the sites of the bonds of G:
+// site n becomes site ord.newSite(n).
+// Bond coordinates and types are kept.
+//
+LatticeGraph inline
+relabel(LatticeGraph const& G,
+        SiteOrder const& ord)
+    {
+    auto Gnew = G;
+    for(auto& b : Gnew)
+        {
+        b.s1 = ord.newSite(b.s1);
+        b.s2 = ord.newSite(b.s2);
+        }
+    return Gnew;
+    }
+
+//
+// Relabel the sites of the terms of an AutoMPO:
+// an operator on site n is moved to site ord.newSite(n).
+// Signs of fermionic terms are updated for the new
+// operator ordering.
+// The new AutoMPO uses the provided SiteSet,
+// which should hold the site type of original site n
+// at position ord.newSite(n) (the SiteSet of ampo
+// can be used if all sites are of the same type).
+//
+AutoMPO inline
+relabel(AutoMPO const& ampo,
+        SiteOrder const& ord,
+        SiteSet const& sites)
+    {
+    auto res = AutoMPO(sites);
+    for(auto& t : ampo.terms())
+        {
+        auto nt = HTerm{};
+        nt.coef = t.coef;
+        for(auto& st : t.ops) nt.add(st.op,ord.newSite(st.i));
+        res.add(nt);
+        }
+    return res;
+    }
+
+AutoMPO inline
+relabel(AutoMPO const& ampo,
+        SiteOrder const& ord)
+    {
+    return relabel(ampo,ord,ampo.sites());
+    }
+
+//
+// Given values v measured on the sites of the
+// reordered system (v[j-1] for position j, as returned
+// by expect), return them in the original site order
+//
+template<typename T>
+std::vector<T>
+toOriginalOrder(SiteOrder const& ord,
+                std::vector<T> const& v)
+    {
+    if(int(v.size()) != ord.length()) Error("toOriginalOrder: wrong number of values");
+    auto res = std::vector<T>{};
+    res.reserve(v.size());
+    for(auto n : range1(ord.length())) res.push_back(v[ord.newSite(n)-1]);
+    return res;
+    }
+
+//
+// Given a matrix C of two-site values measured on the
+// reordered system (C[i-1][j-1] for positions i and j, as
+// returned by correlationMatrix over all sites), return
+// it in the original site order
+//
+template<typename T>
+std::vector<std::vector<T>>
+toOriginalOrderMatrix(SiteOrder const& ord,
+                      std::vector<std::vector<T>> const& C)
+    {
+    auto rows = toOriginalOrder(ord,C);
+    for(auto& r : rows) r = toOriginalOrder(ord,r);
+    return rows;
+    }
+
+} //namespace itensor
+
+#endif
@@ -445,8 +445,23 @@ position(int b, MPS const& psi)
     {
     if(!(*this)) Error("LocalMPO is null");
 
-    makeL(psi,b-1);
-    makeR(psi,b+nc_);
+    //The left and right environments are stored at
+    //different positions of PH_, so when both need
+    //to be (re)built the two chains are made at once
+    auto single = gemmSinglePrecision();
+#pragma omp parallel sections if(LHlim_ < b-1 && RHlim_ > b+nc_)
+        {
+#pragma omp section
+            {
+            auto gemm_mode = GemmPrecisionScope(single);
+            makeL(psi,b-1);
+            }
+#pragma omp section
+            {
+            auto gemm_mode = GemmPrecisionScope(single);
+            makeR(psi,b+nc_);
+            }
+        }
 
     setLHlim(b-1); //not redundant since LHlim_ could be > b-1
     setRHlim(b+nc_); //not redundant since RHlim_ could be < b+nc_
@@ -542,6 +557,8 @@ shift(int j,
 inline void LocalMPO::
 makeL(MPS const& psi, int k)
     {
+    if(LHlim_ >= k) return;
+    TRACE_SCOPE("environment");
     if(!PH_.empty())
         {
         if(Op_ == 0) //Op is actually an MPS
@@ -578,6 +595,8 @@ makeL(MPS const& psi, int k)
 inline void LocalMPO::
 makeR(MPS const& psi, int k)
     {
+    if(RHlim_ <= k) return;
+    TRACE_SCOPE("environment");
     if(!PH_.empty())
         {
         if(Op_ == 0) //Op is actually an MPS
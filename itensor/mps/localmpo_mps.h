@@ -147,10 +147,15 @@ product(ITensor const& phi,
 void inline LocalMPO_MPS::
 position(int b, const MPS& psi)
     {
-    lmpo_.position(b,psi);
-    for(auto& M : lmps_)
+    //Each environment is independent of the others
+    auto nM = long(lmps_.size());
+    auto single = gemmSinglePrecision();
+#pragma omp parallel for schedule(dynamic) if(nM > 0)
+    for(long n = -1; n < nM; ++n)
         {
-        M.position(b,psi);
+        auto gemm_mode = GemmPrecisionScope(single);
+        if(n < 0) lmpo_.position(b,psi);
+        else      lmps_[n].position(b,psi);
         }
     }
 
@@ -19,10 +19,19 @@
 
 namespace itensor {
 
+//
+// Sum of the projections of several MPOs.
+//
+// If ITensor is compiled with OpenMP (ITENSOR_USE_OMP),
+// the products and environment updates of the individual
+// MPOs are carried out concurrently, one MPO per thread.
+// This can be turned off with the arg "ParallelTerms=false".
+//
 class LocalMPOSet
     {
     std::vector<MPO> const* Op_ = nullptr;
     std::vector<LocalMPO> lmpo_;
+    bool parallel_terms_ = true;
     public:
 
     LocalMPOSet(Args const& args = Args::global()) { }
@@ -85,7 +94,7 @@ class LocalMPOSet
     void
     shift(int j, Direction dir, ITensor const& A)
         {
-        for(auto n : range(lmpo_)) lmpo_[n].shift(j,dir,A);
+        forEachTerm([&](size_t n) { lmpo_[n].shift(j,dir,A); });
         }
 
     int
@@ -107,13 +116,25 @@ class LocalMPOSet
         for(auto& lm : lmpo_) lm.doWrite(val,args);
         }
 
+    private:
+
+    //Call f(n) for each term n, concurrently if possible
+    template<typename Func>
+    void
+    forEachTerm(Func&& f) const;
+
+    //Sum of terms, leaving the first in res
+    static void
+    sumTerms(std::vector<ITensor> & terms, ITensor & res);
+
     };
 
 inline LocalMPOSet::
 LocalMPOSet(std::vector<MPO> const& Op,
             Args const& args)
   : Op_(&Op),
-    lmpo_(Op.size())
+    lmpo_(Op.size()),
+    parallel_terms_(args.getBool("ParallelTerms",true))
     { 
     for(auto n : range(lmpo_.size()))
         {
@@ -129,7 +150,8 @@ LocalMPOSet(std::vector<MPO> const& H,
             int RHlim,
             Args const& args)
   : Op_(&H),
-    lmpo_(H.size())
+    lmpo_(H.size()),
+    parallel_terms_(args.getBool("ParallelTerms",true))
     { 
     for(auto n : range(lmpo_.size()))
         {
@@ -137,29 +159,48 @@ LocalMPOSet(std::vector<MPO> const& H,
         }
     }
 
-void inline LocalMPOSet::
-product(ITensor const& phi, 
-        ITensor & phip) const
+template<typename Func>
+void LocalMPOSet::
+forEachTerm(Func&& f) const
     {
-    lmpo_.front().product(phi,phip);
+    auto nterms = lmpo_.size();
+    auto single = gemmSinglePrecision();
+    //Each term only writes to its own LocalMPO
+#pragma omp parallel for schedule(dynamic) if(parallel_terms_ && nterms > 1)
+    for(size_t n = 0; n < nterms; ++n)
+        {
+        auto gemm_mode = GemmPrecisionScope(single);
+        f(n);
+        }
+    }
 
-    ITensor phi_n;
-    for(auto n : range(1,lmpo_.size()))
+void inline LocalMPOSet::
+sumTerms(std::vector<ITensor> & terms, 
+         ITensor & res)
+    {
+    res = std::move(terms.front());
+    for(auto n : range(1,terms.size()))
         {
-        lmpo_[n].product(phi,phi_n);
-        phip += phi_n;
+        res += terms[n];
         }
     }
 
+void inline LocalMPOSet::
+product(ITensor const& phi, 
+        ITensor & phip) const
+    {
+    auto terms = std::vector<ITensor>(lmpo_.size());
+    forEachTerm([&](size_t n) { lmpo_[n].product(phi,terms[n]); });
+    sumTerms(terms,phip);
+    }
+
 Real inline LocalMPOSet::
 expect(ITensor const& phi) const
     {
+    auto ex = std::vector<Real>(lmpo_.size(),0.);
+    forEachTerm([&](size_t n) { ex[n] = lmpo_[n].expect(phi); });
     Real ex_ = 0;
-    for(size_t n = 0; n < lmpo_.size(); ++n)
-    for(auto n : range(lmpo_.size()))
-        {
-        ex_ += lmpo_[n].expect(phi);
-        }
+    for(auto x : ex) ex_ += x;
     return ex_;
     }
 
@@ -168,22 +209,20 @@ deltaRho(ITensor const& AA,
          ITensor const& comb, 
          Direction dir) const
     {
-    ITensor delta = lmpo_.front().deltaRho(AA,comb,dir);
-    for(auto n : range(1,lmpo_.size()))
-        {
-        delta += lmpo_[n].deltaRho(AA,comb,dir);
-        }
+    auto terms = std::vector<ITensor>(lmpo_.size());
+    forEachTerm([&](size_t n) { terms[n] = lmpo_[n].deltaRho(AA,comb,dir); });
+    ITensor delta;
+    sumTerms(terms,delta);
     return delta;
     }
 
 ITensor inline LocalMPOSet::
 diag() const
     {
-    ITensor D = lmpo_.front().diag();
-    for(auto n : range(1,lmpo_.size()))
-        {
-        D += lmpo_[n].diag();
-        }
+    auto terms = std::vector<ITensor>(lmpo_.size());
+    forEachTerm([&](size_t n) { terms[n] = lmpo_[n].diag(); });
+    ITensor D;
+    sumTerms(terms,D);
     return D;
     }
 
@@ -191,10 +230,7 @@ void inline LocalMPOSet::
 position(int b, 
          MPS const& psi)
     {
-    for(auto n : range(lmpo_.size()))
-        {
-        lmpo_[n].position(b,psi);
-        }
+    forEachTerm([&](size_t n) { lmpo_[n].position(b,psi); });
     }
 
 void inline LocalMPOSet::
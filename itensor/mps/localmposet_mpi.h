@@ -0,0 +1,218 @@
+//
+// Copyright 2018 The Simons Foundation, Inc. - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef __ITENSOR_LOCALMPOSET_MPI
+#define __ITENSOR_LOCALMPOSET_MPI
+
+#include "itensor/util/parallel.h"
+#include "itensor/mps/localmposet.h"
+
+namespace itensor {
+
+//
+// Sum of the projections of several MPOs, with the
+// MPOs distributed over MPI nodes (MPO n is owned by
+// node n % nnodes). Each node keeps the environments of
+// its own MPOs only; the results of product, diag, expect
+// and deltaRho are summed over all nodes.
+//
+// Every node must call every method in the same order
+// with the same arguments, which is the case when each
+// node runs the same algorithm, e.g.
+//
+//   seedRNG(1); //davidson may draw random vectors
+//   auto PH = LocalMPOSet_MPI(env,Hterms);
+//   auto energy = DMRGWorker(psi,PH,sweeps,args);
+//
+// H must have the same index ids on every node. Other indices
+// (links of psi created during the algorithm) may have different
+// ids on different nodes: before summing, the indices of each
+// tensor are matched to those of node 0 by their tags, prime
+// level and dimension. Indices alike in all three (such as
+// untagged sites) are matched by id, so must have the same
+// ids on every node.
+//
+// Within a node, the MPOs are handled concurrently
+// as described for LocalMPOSet.
+//
+class LocalMPOSet_MPI
+    {
+    Environment const* env_ = nullptr;
+    std::vector<MPO> terms_;
+    LocalMPOSet lset_;
+    public:
+
+    LocalMPOSet_MPI(Environment const& env,
+                    std::vector<MPO> const& H,
+                    Args const& args = Args::global());
+
+    LocalMPOSet_MPI(LocalMPOSet_MPI const&) = delete;
+    LocalMPOSet_MPI& operator=(LocalMPOSet_MPI const&) = delete;
+
+    void
+    product(ITensor const& phi,
+            ITensor & phip) const;
+
+    Real
+    expect(ITensor const& phi) const;
+
+    ITensor
+    deltaRho(ITensor const& AA,
+             ITensor const& comb,
+             Direction dir) const;
+
+    ITensor
+    diag() const;
+
+    void
+    position(int b,
+             MPS const& psi) { lset_.position(b,psi); }
+
+    int
+    numCenter() const { return lset_.numCenter(); }
+    void
+    numCenter(int val) { lset_.numCenter(val); }
+
+    size_t
+    size() const { return lset_.size(); }
+
+    explicit
+    operator bool() const { return bool(lset_); }
+
+    bool
+    doWrite() const { return lset_.doWrite(); }
+    void
+    doWrite(bool val, Args const& args = Args::global()) { lset_.doWrite(val,args); }
+
+    //MPOs owned by this node
+    std::vector<MPO> const&
+    terms() const { return terms_; }
+
+    private:
+
+    //Sum T over all nodes
+    ITensor
+    allSumTensor(ITensor T) const;
+
+    };
+
+inline LocalMPOSet_MPI::
+LocalMPOSet_MPI(Environment const& env,
+                std::vector<MPO> const& H,
+                Args const& args)
+  : env_(&env)
+    {
+    if(H.size() < size_t(env.nnodes()))
+        {
+        Error(format("LocalMPOSet_MPI: need at least one MPO per node (%d MPOs, %d nodes)",
+                     H.size(),env.nnodes()));
+        }
+    for(auto n : range(H.size()))
+        {
+        if(int(n)%env.nnodes() == env.rank()) terms_.push_back(H[n]);
+        }
+    lset_ = LocalMPOSet(terms_,args);
+    }
+
+namespace detail {
+
+//Sum T over all nodes, matching the indices of T
+//to those on node 0 as described for LocalMPOSet_MPI
+ITensor inline
+allSumMatched(Environment const& env,
+              ITensor T)
+    {
+    if(env.nnodes() == 1) return T;
+    auto alike = [](Index const& a, Index const& b)
+        {
+        return tags(a) == tags(b) && primeLevel(a) == primeLevel(b) && dim(a) == dim(b);
+        };
+    auto v = std::vector<Index>{};
+    for(auto& i : inds(T)) v.push_back(i);
+    std::sort(v.begin(),v.end(),
+              [](Index const& a, Index const& b)
+              {
+              auto ta = std::string(tags(a)),
+                   tb = std::string(tags(b));
+              if(ta != tb) return ta < tb;
+              if(primeLevel(a) != primeLevel(b)) return primeLevel(a) < primeLevel(b);
+              if(dim(a) != dim(b)) return dim(a) < dim(b);
+              return id(a) < id(b);
+              });
+    auto is = IndexSet(v);
+    auto ris = is;
+    broadcast(env,ris);
+    if(!env.firstNode())
+        {
+        //Alike indices are ordered by id, which only
+        //matches node 0 if their ids are the same
+        for(size_t n = 1; n < v.size(); ++n)
+            {
+            if(!alike(v[n-1],v[n])) continue;
+            if(id(v[n-1]) != id(ris[n-1]) || id(v[n]) != id(ris[n]))
+                {
+                Error(format("LocalMPOSet_MPI: cannot match index %s to node 0, another index has the same tags, prime level and dimension",v[n]));
+                }
+            }
+        T.replaceInds(is,ris);
+        }
+    T = allSum(env,T);
+    if(!env.firstNode()) T.replaceInds(ris,is);
+    return T;
+    }
+
+} //namespace detail
+
+ITensor inline LocalMPOSet_MPI::
+allSumTensor(ITensor T) const
+    {
+    return detail::allSumMatched(*env_,std::move(T));
+    }
+
+void inline LocalMPOSet_MPI::
+product(ITensor const& phi,
+        ITensor & phip) const
+    {
+    lset_.product(phi,phip);
+    phip = allSumTensor(std::move(phip));
+    //Same memory layout on every node, so that
+    //the nodes go on to do identical computations
+    phip.permute(inds(phi));
+    }
+
+Real inline LocalMPOSet_MPI::
+expect(ITensor const& phi) const
+    {
+    auto ex = lset_.expect(phi);
+    return allSum(*env_,ex);
+    }
+
+ITensor inline LocalMPOSet_MPI::
+deltaRho(ITensor const& AA,
+         ITensor const& comb,
+         Direction dir) const
+    {
+    return allSumTensor(lset_.deltaRho(AA,comb,dir));
+    }
+
+ITensor inline LocalMPOSet_MPI::
+diag() const
+    {
+    return allSumTensor(lset_.diag());
+    }
+
+} //namespace itensor
+
+#endif
@@ -15,6 +15,7 @@
 //
 #ifndef __ITENSOR_LOCAL_OP
 #define __ITENSOR_LOCAL_OP
+#include <array>
 #include "itensor/itensor.h"
 //#include "itensor/util/print_macro.h"
 
@@ -49,6 +50,10 @@ class LocalOp
     ITensor const* R_;
     mutable size_t size_;
     int nc_;
+    //Intermediate results of product, whose storage
+    //is reused by later calls with the same phi structure
+    mutable ITensor work1_,
+                    work2_;
     public:
 
 
@@ -327,38 +332,50 @@ product(ITensor const& phi,
     {
     if(!(*this)) Error("LocalOp is null");
 
+    //Tensors to multiply phi by, in order
+    auto ops = std::array<ITensor const*,4>{};
+    size_t nops = 0;
     if(LIsNull())
         {
-        phip = phi;
-        if(!RIsNull()) 
-            phip *= R(); //m^3 k d
+        if(!RIsNull()) ops[nops++] = &R(); //m^3 k d
         
         if(nc_ == 2)
             {
-            phip *= (*Op2_); //m^2 k^2
-            phip *= (*Op1_); //m^2 k^2
+            ops[nops++] = Op2_; //m^2 k^2
+            ops[nops++] = Op1_; //m^2 k^2
             }
         else if(nc_ == 1)
             {
-            phip *= (*Op1_);
+            ops[nops++] = Op1_;
             }
         }
     else
         {
-        phip = phi * L(); //m^3 k d
+        ops[nops++] = &L(); //m^3 k d
 
         if(nc_ == 2)
             {
-            phip *= (*Op1_); //m^2 k^2
-            phip *= (*Op2_); //m^2 k^2
+            ops[nops++] = Op1_; //m^2 k^2
+            ops[nops++] = Op2_; //m^2 k^2
             }
         else if(nc_ == 1)
             {
-            phip *= (*Op1_);
+            ops[nops++] = Op1_;
             }
 
-        if(!RIsNull()) 
-            phip *= R();
+        if(!RIsNull()) ops[nops++] = &R();
+        }
+
+    //Intermediate results alternate between work1_ and work2_,
+    //written in place when their structure is unchanged since
+    //the last call (as over the iterations of davidson)
+    if(nops == 0) phip = phi;
+    auto* cur = &phi;
+    for(auto n : range(nops))
+        {
+        auto& res = (n+1 == nops) ? phip : ((n%2 == 0) ? work1_ : work2_);
+        contract(*cur,*ops[n],res);
+        cur = &res;
         }
 
     phip.noPrime();
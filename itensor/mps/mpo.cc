@@ -623,24 +623,79 @@ inner(MPS const& x,
     auto xdag = dag(xp);
     xdag.replaceLinkInds(sim(linkInds(xdag)));
 
-    auto L = y(1) * A(1) * xdag(1);
-
     // TODO: some MPOs may store edge tensors
     // in A(0) and A(N+1). Add this back?
     //L *= (A(0) ? A(0)*A(1) : A(1));
-
-    for( auto n : range1(2,N) ) 
-        L = L * y(n) * A(n) * xdag(n); 
-
-    // TODO: some MPOs may store edge tensors
-    // in A(0) and A(N+1). Add this back?
     //if(A(N+1)) L *= A(N+1);
 
-    auto z = eltC(L);
+    //Contract the left and right halves concurrently
+    //and join them in the middle
+    auto c = N/2;
+    auto L = ITensor(1.),
+         R = ITensor(1.);
+#pragma omp parallel sections if(N >= 8)
+        {
+#pragma omp section
+        for(auto n : range1(c)) 
+            L = L * y(n) * A(n) * xdag(n); 
+#pragma omp section
+        for(auto n = N; n > c; --n) 
+            R = R * y(n) * A(n) * xdag(n); 
+        }
+
+    auto z = eltC(L*R);
     re = real(z);
     im = imag(z);
     }
 
+CMatrix
+innerMatrix(std::vector<MPS> const& psis,
+            MPO const& A)
+    {
+    auto k = psis.size();
+    auto G = CMatrix(k,k);
+    if(k == 0) return G;
+    auto N = length(A);
+    for(auto& p : psis) if(length(p) != N) Error("innerMatrix: mismatched N");
+
+    // Put the kets on the unprimed site indices of A,
+    // make the indices of the bras match those of A|ket>,
+    // and dagger each state only once
+    auto sx = IndexSetBuilder(N);
+    for(auto n : range1(N)) sx.nextIndex(siteIndex(A,n));
+    auto sites = sx.build();
+    auto sAy = uniqueSiteInds(A,sites);
+    auto kets = psis;
+    auto bras = std::vector<MPS>(k);
+    for(auto i : range(k))
+        {
+        kets[i].replaceSiteInds(sites);
+        bras[i] = dag(replaceSiteInds(psis[i],sAy));
+        bras[i].replaceLinkInds(sim(linkInds(bras[i])));
+        }
+
+    //All pairs advance together site by site, so each
+    //site tensor is used by every pair while it is hot
+    auto L = std::vector<ITensor>(k*k,ITensor(1.));
+    for(auto n : range1(N))
+        {
+#pragma omp parallel for schedule(dynamic)
+        for(size_t p = 0; p < k*k; ++p)
+            {
+            auto i = p/k,
+                 j = p%k;
+            L[p] = L[p] * kets[j](n) * A(n) * bras[i](n);
+            }
+        }
+
+    for(auto i : range(k))
+    for(auto j : range(k))
+        {
+        G(i,j) = eltC(L[i*k+j]);
+        }
+    return G;
+    }
+
 Real 
 inner(MPS const& psi, 
       MPO const& H, 
@@ -426,6 +426,14 @@ innerC(MPS const& x,
        MPO const& A, 
        MPS const& y);
 
+// Matrix G(i,j) = <psis[i]|A|psis[j]>, computed in a
+// single left-to-right pass with the pairs handled
+// concurrently. The states are put on the unprimed
+// site indices of A, so they may use other copies.
+CMatrix
+innerMatrix(std::vector<MPS> const& psis,
+            MPO const& A);
+
 // Generic calculate <x|A|y> 
 template <typename T> 
 T 
@@ -499,6 +507,12 @@ innerC(MPS const& x,
        MPS const& y);
 
 // Calculate AB
+//
+// {"Method=","ZipUp"} (default): multiply in one site of A and B
+// at a time, truncating each new bond with "Cutoff" and "MaxDim".
+// {"Method=","Fit"}: improve the "ZipUp" result with "Nsweep"
+// (default 1) two-site sweeps maximizing its overlap with AB,
+// which is more accurate at a given "MaxDim".
 void 
 nmultMPO(MPO const& Aorig, 
          MPO const& Borig, 
@@ -521,9 +535,19 @@ nmultMPO(MPO const& A,
 //be controllably truncated further by providing
 //optional truncation args "Cutoff" and "MaxDim"
 //
+//{"Method=","ZipUp"}
+//Applies an MPO K to an MPS x in a single sweep from left to right,
+//multiplying in one site of K and x at a time and truncating with an SVD.
+//The truncation while zipping up is looser than the requested one
+//("ZipUpCutoff", default Cutoff/10, and "ZipUpMaxDim", default 2*MaxDim)
+//and the result is then recompressed in a sweep back to site 1.
+//Much cheaper than "DensityMatrix" for large bond dimensions, though
+//less accurate when K is far from unitary.
+//
 //{"Method=","Fit"}
 //Applies an MPO K to an MPS psi (|res>=K|psi>) using a sweeping/DMRG-like
-//fitting approach. Warning: this method can get stuck i.e. fail to converge
+//fitting approach, starting from the "ZipUp" result.
+//Warning: this method can get stuck i.e. fail to converge
 //if the initial value of res is too different from the product K|psi>.
 //List of options recognized:
 //   Normalize (default: true) - normalize state to 1 after applying MPO
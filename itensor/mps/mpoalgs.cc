@@ -30,6 +30,64 @@ using std::pair;
 using std::make_pair;
 using std::string;
 
+//
+// Improve res ~= A*B by two-site sweeps maximizing
+// the overlap of res with A*B, as in fitApplyMPOImpl
+//
+void
+fitNmultMPO(MPO const& A,
+            MPO const& B,
+            MPO & res,
+            Args const& args)
+    {
+    auto N = length(A);
+    auto nsweep = args.getInt("Nsweep",1);
+    auto verbose = args.getBool("Verbose",false);
+
+    res.position(1);
+    res.dag();
+    // Replace the link indices of res with similar
+    // ones so they don't clash with the links of A
+    res.replaceLinkInds(sim(linkInds(res)));
+
+    auto E = vector<ITensor>(N+2,ITensor(1.));
+    for(auto n = N; n > 2; --n)
+        {
+        E[n] = E[n+1]*A(n)*B(n)*res(n);
+        }
+
+    for(auto sw : range1(nsweep))
+        {
+        for(int b = 1, ha = 1; ha <= 2; sweepnext(b,ha,N))
+            {
+            //The two halves of the local product are
+            //independent, so are built concurrently
+            ITensor lwf,rwf;
+#pragma omp parallel sections
+                {
+#pragma omp section
+                lwf = E[b-1]*A(b)*B(b);
+#pragma omp section
+                rwf = E[b+2]*A(b+1)*B(b+1);
+                }
+
+            auto wf = lwf*rwf;
+            wf.dag();
+            auto spec = res.svdBond(b,wf,(ha==1?Fromleft:Fromright),args);
+
+            if(verbose)
+                {
+                printfln("Sweep=%d, HS=%d, Bond=(%d,%d) Trunc. err=%.1E, States kept=%s",
+                         sw,ha,b,b+1,spec.truncerr(),showDim(linkIndex(res,b)));
+                }
+
+            if(ha == 1) E[b] = lwf*res(b);
+            else        E[b+1] = rwf*res(b+1);
+            }
+        }
+    res.dag();
+    }
+
 void
 nmultMPO(MPO const& Aorig,
          MPO const& Borig,
@@ -38,6 +96,11 @@ nmultMPO(MPO const& Aorig,
     {
     if(!args.defined("Cutoff")) args.add("Cutoff",1E-14);
     if(!args.defined("RespectDegenerate")) args.add("RespectDegenerate",true);
+    auto method = args.getString("Method","ZipUp");
+    if(method != "ZipUp" && method != "Fit")
+        {
+        throw ITError("nmultMPO currently supports the following methods: 'ZipUp', 'Fit'");
+        }
 
     if(length(Aorig) != length(Borig)) Error("nmultMPO(MPO): Mismatched MPO length");
     const int N = length(Borig);
@@ -97,6 +160,8 @@ nmultMPO(MPO const& Aorig,
 
     res.svdBond(N-1,nfork,Fromright, args);
     res.orthogonalize();
+
+    if(method == "Fit") fitNmultMPO(A,B,res,args);
     }
 
 MPO
@@ -118,6 +183,11 @@ densityMatrixApplyMPOImpl(MPO const& K,
                           MPS const& x,
                           Args args = Args::global());
 
+MPS
+zipUpApplyMPOImpl(MPO const& K,
+                  MPS const& x,
+                  Args const& args = Args::global());
+
 void
 fitApplyMPOImpl(MPS const& psi,
                 MPO const& K,
@@ -140,20 +210,21 @@ applyMPO(MPO const& K,
         {
         res = densityMatrixApplyMPOImpl(K,x,args);
         }
+    else if(method == "ZipUp")
+        {
+        res = zipUpApplyMPOImpl(K,x,args);
+        }
     else if(method == "Fit")
         {
-        // Use the input MPS x to be applied as the
-        // default starting state
-        // TODO: consider using zipUpApplyMPOImpl as 
-        // a way to get a better starting state
-        auto sites = uniqueSiteInds(K,x);
-        res = replaceSiteInds(x,sites);
-        //res = x;
+        // Use the zip-up result as the starting state,
+        // which is usually close enough to K|x> that
+        // one or two sweeps are enough
+        res = zipUpApplyMPOImpl(K,x,{args,"Normalize=",false});
         fitApplyMPOImpl(x,K,res,args);
         }
     else
         {
-        Error("applyMPO currently supports the following methods: 'DensityMatrix', 'Fit'");
+        Error("applyMPO currently supports the following methods: 'DensityMatrix', 'ZipUp', 'Fit'");
         }
 
     return res;
@@ -174,12 +245,12 @@ applyMPO(MPO const& K,
     if(!args.defined("RespectDegenerate")) args.add("RespectDegenerate",true);
 
     MPS res = x0;
-    if(method == "DensityMatrix")
-        Error("applyMPO method 'DensityMatrix' does not accept an input MPS");
+    if(method == "DensityMatrix" || method == "ZipUp")
+        Error(format("applyMPO method '%s' does not accept an input MPS",method));
     else if(method == "Fit")
         fitApplyMPOImpl(x,K,res,args);
     else
-        Error("applyMPO currently supports the following methods: 'DensityMatrix', 'Fit'");
+        Error("applyMPO currently supports the following methods: 'DensityMatrix', 'ZipUp', 'Fit'");
 
     return res;
     }
@@ -307,6 +378,66 @@ densityMatrixApplyMPOImpl(MPO const& K,
     return res;
     }
 
+MPS
+zipUpApplyMPOImpl(MPO const& K,
+                  MPS const& psi,
+                  Args const& args)
+    {
+    auto cutoff = args.getReal("Cutoff",1E-13);
+    auto dargs = Args{"Cutoff",cutoff};
+    auto maxdim_set = args.defined("MaxDim");
+    if(maxdim_set) dargs.add("MaxDim",args.getInt("MaxDim"));
+    dargs.add("RespectDegenerate",args.getBool("RespectDegenerate",true));
+    auto verbose = args.getBool("Verbose",false);
+    auto normalize = args.getBool("Normalize",false);
+
+    //Truncation while zipping up is looser than the final one,
+    //since the sweep back recompresses every bond
+    auto zargs = Args{"Cutoff",args.getReal("ZipUpCutoff",0.1*cutoff)};
+    if(args.defined("ZipUpMaxDim")) zargs.add("MaxDim",args.getInt("ZipUpMaxDim"));
+    else if(maxdim_set)             zargs.add("MaxDim",2*args.getInt("MaxDim"));
+    zargs.add("RespectDegenerate",dargs.getBool("RespectDegenerate"));
+
+    auto N = length(psi);
+    if(length(K) != N) Error("Mismatched lengths of MPO and MPS in applyMPO method 'ZipUp'");
+
+    for( auto n : range1(N) )
+      {
+      if( commonIndex(psi(n),K(n)) != siteIndex(psi,n) )
+          Error("MPS and MPO have different site indices in applyMPO method 'ZipUp'");
+      }
+
+    //The truncations are only optimal
+    //with x right-orthogonal past site 1
+    auto x = psi;
+    if(not isOrtho(x) || orthoCenter(x) != 1) x.position(1);
+
+    auto res = MPS(N);
+    auto R = ITensor(1.);
+    for(auto j : range1(N-1))
+        {
+        R = R*x(j)*K(j);
+        auto Uis = IndexSet(uniqueSiteIndex(K,x,j));
+        if(j > 1) Uis = IndexSet(commonIndex(res(j-1),R),uniqueSiteIndex(K,x,j));
+        auto ts = tags(linkIndex(x,j));
+        ITensor U(Uis),S,V;
+        auto spec = svd(R,U,S,V,{zargs,"LeftTags=",ts});
+        if(verbose) printfln("  j=%02d truncerr=%.2E dim=%d",j,spec.truncerr(),dim(commonIndex(U,S)));
+        res.ref(j) = U;
+        R = S*V;
+        }
+    R = R*x(N)*K(N);
+    if(normalize) R /= norm(R);
+    res.ref(N) = R;
+    res.leftLim(N-1);
+    res.rightLim(N+1);
+
+    //Sweep back, truncating to the requested accuracy
+    res.position(1,dargs);
+
+    return res;
+    }
+
 void
 oneSiteFitApply(vector<ITensor> & E,
                 Real fac,
@@ -613,84 +744,6 @@ applyExpH(MPS const& psi,
 // Deprecated
 //
 
-//
-// For now this is unsupported
-// We can consider bringing it back for example
-// as a way to get a default starting MPS
-// for fitApplyMPOImpl
-//
-
-//void 
-//zipUpApplyMPOImpl(MPS const& psi, 
-//                  MPO const& K, 
-//                  MPS& res, 
-//                  Args const& args)
-//    {
-//    const
-//    bool allow_arb_position = args.getBool("AllowArbPosition",false);
-//
-//    if(&psi == &res)
-//        Error("psi and res must be different MPS instances");
-//
-//    auto N = length(psi);
-//    if(length(K) != N) 
-//        Error("Mismatched N in ApplyMPO() ZipUp method");
-//
-//    if(!itensor::isOrtho(psi) || itensor::orthoCenter(psi) != 1)
-//        Error("Ortho center of psi must be site 1");
-//
-//    if(!allow_arb_position && (!itensor::isOrtho(K) || itensor::orthoCenter(K) != 1))
-//        Error("Ortho center of K must be site 1");
-//
-//#ifdef DEBUG
-//    checkQNs(psi);
-//    checkQNs(K);
-//    /*
-//    cout << "Checking divergence in zip" << endl;
-//    for(int i = 1; i <= N; i++)
-//	div(psi(i));
-//    for(int i = 1; i <= N; i++)
-//	div(K(i));
-//    cout << "Done Checking divergence in zip" << endl;
-//    */
-//#endif
-//
-//    res = psi; 
-//    res.replaceTags("0","4","Link");
-//    res.replaceTags("0","1","Site");
-//
-//    ITensor clust,nfork;
-//    vector<int> midsize(N);
-//    int maxdim = 1;
-//    for(int i = 1; i < N; i++)
-//        {
-//        if(i == 1) { clust = psi(i) * K(i); }
-//        else { clust = nfork * (psi(i) * K(i)); }
-//        if(i == N-1) break; //No need to SVD for i == N-1
-//
-//        Index oldmid = linkIndex(res,i); assert(oldmid.dir() == Out);
-//        nfork = ITensor(linkIndex(psi,i),linkIndex(K,i-1),oldmid);
-//        //if(clust.iten_size() == 0)	// this product gives 0 !!
-//	    //throw ResultIsZero("clust.iten size == 0");
-//        denmatDecomp(clust, res.ref(i), nfork,Fromleft,args);
-//        Index mid = commonIndex(res(i),nfork);
-//        //assert(mid.dir() == In);
-//        mid.dag();
-//        midsize[i] = dim(mid);
-//        maxdim = std::max(midsize[i],maxdim);
-//        assert(linkIndex(res,i+1).dir() == Out);
-//        res.ref(i+1) = ITensor(mid,prime(res.sites()(i+1)),linkIndex(res,i+1));
-//        }
-//    nfork = clust * psi(N) * K(N);
-//    //if(nfork.iten_size() == 0)	// this product gives 0 !!
-//    //throw ResultIsZero("nfork.iten size == 0");
-//
-//    res.svdBond(N-1,nfork,Fromright,args);
-//    res.noPrime("Link");
-//    res.replaceTags("1","0","Site");
-//    res.position(1);
-//    } //void zipUpApplyMPOImpl
-
 //
 // These versions calculate |res> = |psiA> + mpofac*H*|psiB>
 // Currently they are unsupported
@@ -20,6 +20,7 @@
 #include "itensor/util/print_macro.h"
 #include "itensor/util/str.h"
 #include "itensor/tensor/algs.h"
+#include <map>
 
 namespace itensor {
 
@@ -624,6 +625,18 @@ svdBond(int b, ITensor const& AA, Direction dir, Args args)
     return svdBond(b,AA,dir,LocalOp(),args);
     }
 
+TruncateOptions
+svdBondTruncateOptions(Args const& args)
+    {
+    //Defaults depend on whether svdBond will use
+    //an SVD or a density matrix decomposition
+    auto usesvd = args.getBool("UseSVD",false)
+               || (args.getReal("Noise",0.) == 0 && args.getReal("Cutoff",MIN_CUT) < 1E-12);
+    auto opts = TruncateOptions(args,usesvd ? svdTruncateDefaults() : diagTruncateDefaults());
+    opts.respectDegenerate = args.getBool("RespectDegenerate",true);
+    return opts;
+    }
+
 struct SqrtInv
     {
     Real
@@ -640,6 +653,42 @@ struct Sqrt
     operator()(Real val) const { return std::sqrt(std::fabs(val)); }
     };
 
+//Whether each block of L, viewed as a matrix from its
+//other indices to bnd, has at least as many rows as
+//columns, so a QR of it needs no pivoting
+bool
+qrBlocksTall(ITensor const& L, Index const& bnd)
+    {
+    if(not hasQNs(L)) return long(dim(bnd))*long(dim(bnd)) <= long(dim(inds(L)));
+
+    //Number of rows of each QN sector
+    auto rows = std::map<QN,long>{{QN(),1l}};
+    for(auto& I : inds(L))
+        {
+        if(I == bnd) continue;
+        auto next = std::map<QN,long>{};
+        for(auto& [q,d] : rows)
+        for(auto b : range1(nblock(I)))
+            {
+            next[q+dir(I)*qn(I,b)] += d*blocksize(I,b);
+            }
+        rows = std::move(next);
+        }
+    //Blocks of bnd with the same QN form one block
+    //once bnd is combined by qr
+    auto cols = std::map<QN,long>{};
+    for(auto b : range1(nblock(bnd)))
+        {
+        cols[div(L)-dir(bnd)*qn(bnd,b)] += blocksize(bnd,b);
+        }
+    for(auto& [q,d] : cols)
+        {
+        auto r = rows.find(q);
+        if(r != rows.end() && r->second < d) return false;
+        }
+    return true;
+    }
+
 Spectrum
 orthMPS(ITensor& A1, ITensor& A2, Direction dir, Args const& args)
     {
@@ -654,6 +703,22 @@ orthMPS(ITensor& A1, ITensor& A2, Direction dir, Args const& args)
         Print(inds(L));
         }
 
+    //Without truncation a QR decomposition moves
+    //the gauge as well as an SVD, at a fraction of the cost.
+    //A bond larger than the other indices of L (in any QN
+    //block) is reduced by the SVD instead, which also
+    //reveals the rank.
+    auto truncate = args.getBool("Truncate",args.defined("Cutoff") || args.defined("MaxDim") 
+                                            || args.defined("Maxm"));
+    if(not truncate && not args.getBool("UseSVD",false) && qrBlocksTall(L,bnd))
+        {
+        ITensor Q,Rm(bnd);
+        qr(L,Q,Rm,{"InternalTags=",getTagSet(args,"LeftTags","Link,U")});
+        L = Q;
+        R *= Rm;
+        return Spectrum();
+        }
+
     ITensor A,B(bnd);
     ITensor D;
     auto spec = svd(L,A,D,B,args);
@@ -756,6 +821,16 @@ orthogonalize(Args args)
     auto& psi = *this;
     auto N = N_;
 
+    //Without truncation, a single sweep of
+    //QR decompositions back to site 1 is enough
+    if(not args.getBool("Truncate",true))
+        {
+        l_orth_lim_ = 0;
+        r_orth_lim_ = N+1;
+        position(1);
+        return *this;
+        }
+
     auto cutoff = args.getReal("Cutoff",1E-13);
     auto dargs = Args{"Cutoff",cutoff};
     auto maxdim_set = args.defined("MaxDim");
@@ -1470,8 +1545,8 @@ template MPO sum<MPO>(MPO const& L, MPO const& R, Args const& args);
 
 template <class MPSType>
 MPSType
-sum(std::vector<MPSType> const& terms, 
-    Args const& args)
+pairwiseSum(std::vector<MPSType> const& terms, 
+            Args const& args)
     {
     auto Nt = terms.size();
     if(Nt == 2)
@@ -1489,17 +1564,72 @@ sum(std::vector<MPSType> const& terms,
         //Add all MPS in pairs
         auto nsize = (Nt%2==0 ? Nt/2 : (Nt-1)/2+1);
         std::vector<MPSType> newterms(nsize); 
-        for(decltype(Nt) n = 0, np = 0; n < Nt-1; n += 2, ++np)
+#pragma omp parallel for schedule(dynamic)
+        for(decltype(Nt) np = 0; np < Nt/2; ++np)
             {
-            newterms.at(np) = sum(terms.at(n),terms.at(n+1),args);
+            newterms.at(np) = sum(terms.at(2*np),terms.at(2*np+1),args);
             }
         if(Nt%2 == 1) newterms.at(nsize-1) = terms.back();
 
         //Recursively call sum again
-        return sum(newterms,args);
+        return pairwiseSum(newterms,args);
         }
     return MPSType();
     }
+
+template <class MPSType>
+MPSType
+sum(std::vector<MPSType> const& terms, 
+    Args const& args)
+    {
+    auto method = args.getString("Method","DirectSum");
+    if(method == "Pairwise") return pairwiseSum(terms,args);
+    if(method != "DirectSum" && method != "Fit")
+        {
+        throw ITError(format("sum: Method %s not recognized",method));
+        }
+
+    auto Nt = terms.size();
+    if(Nt == 0) return MPSType();
+    if(Nt == 1) return terms.front();
+
+    //Group consecutive terms so that the direct sum
+    //of each group has bond dimension at most maxsum
+    auto maxsum = args.getInt("MaxSumDim",2000);
+    auto groups = std::vector<std::vector<MPSType>>{};
+    auto gdim = 0;
+    for(auto& t : terms)
+        {
+        auto m = maxLinkDim(t);
+        if(groups.empty() || (groups.back().size() > 1 && gdim+m > maxsum))
+            {
+            groups.emplace_back();
+            gdim = 0;
+            }
+        groups.back().push_back(t);
+        gdim += m;
+        }
+
+    auto partial = std::vector<MPSType>(groups.size());
+#pragma omp parallel for schedule(dynamic) if(groups.size() > 1)
+    for(size_t g = 0; g < groups.size(); ++g)
+        {
+        if(groups[g].size() == 1)
+            {
+            partial[g] = groups[g].front();
+            continue;
+            }
+        partial[g] = directSum(groups[g]);
+        partial[g].orthogonalize(args);
+        }
+
+    auto res = (partial.size() == 1) 
+             ? std::move(partial.front()) 
+             : sum(partial,{args,"Method=","DirectSum"});
+
+    if(method == "Fit") fitSum(terms,res,args);
+    return res;
+    }
 template MPS sum<MPS>(std::vector<MPS> const& terms, Args const& args);
 template MPO sum<MPO>(std::vector<MPO> const& terms, Args const& args);
 
@@ -1514,11 +1644,74 @@ innerC(MPS const& psi,
     psidag.replaceSiteInds(siteInds(phi));
     psidag.replaceLinkInds(sim(linkInds(psidag)));
 
-    auto L = phi(1) * psidag(1);
-    if(N == 1) return eltC(L);
-    for(auto i : range1(2,N) ) 
-        L = L * phi(i) * psidag(i);
-    return eltC(L);
+    //Contract the left and right halves concurrently
+    //and join them in the middle
+    auto c = N/2;
+    auto L = ITensor(1.),
+         R = ITensor(1.);
+#pragma omp parallel sections if(N >= 8)
+        {
+#pragma omp section
+        for(auto i : range1(c)) 
+            L = L * phi(i) * psidag(i);
+#pragma omp section
+        for(auto i = N; i > c; --i) 
+            R = R * phi(i) * psidag(i);
+        }
+    return eltC(L*R);
+    }
+
+CMatrix
+innerMatrix(std::vector<MPS> const& psis)
+    {
+    auto k = psis.size();
+    auto G = CMatrix(k,k);
+    if(k == 0) return G;
+    auto N = length(psis.front());
+    for(auto& p : psis) if(length(p) != N) Error("innerMatrix: mismatched N");
+
+    //Make the site indices match those of the first state,
+    //and dagger each state (with new link indices) only once
+    auto sites = siteInds(psis.front());
+    auto kets = psis;
+    auto bras = std::vector<MPS>(k);
+    for(auto i : range(k))
+        {
+        kets[i].replaceSiteInds(sites);
+        bras[i] = dag(kets[i]);
+        bras[i].replaceLinkInds(sim(linkInds(bras[i])));
+        }
+
+    //G is Hermitian: only compute pairs with i <= j
+    auto pairs = std::vector<std::pair<size_t,size_t>>{};
+    for(auto i : range(k))
+    for(auto j : range(i,k))
+        {
+        pairs.emplace_back(i,j);
+        }
+
+    //All pairs advance together site by site, so each
+    //site tensor is used by every pair while it is hot
+    auto L = std::vector<ITensor>(pairs.size(),ITensor(1.));
+    for(auto n : range1(N))
+        {
+#pragma omp parallel for schedule(dynamic)
+        for(size_t p = 0; p < pairs.size(); ++p)
+            {
+            auto i = pairs[p].first,
+                 j = pairs[p].second;
+            L[p] = L[p] * kets[j](n) * bras[i](n);
+            }
+        }
+
+    for(auto p : range(pairs.size()))
+        {
+        auto i = pairs[p].first,
+             j = pairs[p].second;
+        G(i,j) = eltC(L[p]);
+        G(j,i) = std::conj(G(i,j));
+        }
+    return G;
     }
 
 void
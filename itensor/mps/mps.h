@@ -384,11 +384,26 @@ class MPS
             LocalOpT const& PH, 
             Args args = Args::global());
 
+    //Version taking truncation options already parsed
+    //by svdBondTruncateOptions, for loops over many bonds
+    template<class LocalOpT>
+    Spectrum 
+    svdBond(int b, 
+            ITensor const& AA, 
+            Direction dir, 
+            LocalOpT const& PH, 
+            TruncateOptions const& opts,
+            Args const& args = Args::global());
+
     //Move the orthogonality center to site i 
     //(leftLim() == i-1, rightLim() == i+1, orthoCenter() == i)
+    //Uses QR decompositions unless truncation
+    //args ("Cutoff", "MaxDim") are provided
     MPS& 
     position(int i, Args args = Args::global());
 
+    //With {"Truncate=",false}, orthogonalizes
+    //with QR decompositions only
     MPS& 
     orthogonalize(Args args = Args::global());
 
@@ -730,6 +745,11 @@ isOrtho(MPS const& x);
 int
 orthoCenter(MPS const& x);
 
+//Truncation options MPS::svdBond reads from args
+//("RespectDegenerate" defaults to true)
+TruncateOptions
+svdBondTruncateOptions(Args const& args);
+
 int
 rightLim(MPS const& x);
 
@@ -841,6 +861,12 @@ inner(MPS const& x,
       MPS const& y, 
       Real& re, Real& im);
 
+// Matrix of overlaps G(i,j) = <psis[i]|psis[j]>,
+// computed in a single left-to-right pass with
+// the pairs handled concurrently
+CMatrix
+innerMatrix(std::vector<MPS> const& psis);
+
 //Computes an MPS which has the same overlap with x_basis as x_to_fit,
 //but which differs from x_basis only on the first site, and has same index
 //structure as x_basis. Result is stored to x_to_fit on return.
@@ -855,18 +881,77 @@ sum(MPSType const& L,
 
 
 //
-// Template method for efficiently summing 
-// a set of MPS's or MPO's (or any class supporting operator+=)
-// Performs the sum in a tree-like fashion in an attempt to
-// leave the largest summands for the last few steps
+// Sum of a set of MPS's or MPO's, assumed zero-indexed
 //
-// Assumes terms are zero-indexed
+// Named arguments recognized:
+//
+//   "Method" -- "DirectSum" (default): form the block-diagonal
+//               direct sum of the terms, then compress it with
+//               a single orthogonalize sweep using the truncation
+//               args. If the summed bond dimension of the terms
+//               exceeds "MaxSumDim" (default 2000) the terms are
+//               split into groups which are direct-summed and
+//               compressed in parallel, then summed again.
+//               "Fit": as "DirectSum", then improve the result
+//               with "Nsweep" (default 1) variational sweeps
+//               fitting it to all terms at once.
+//               "Pairwise": add the terms in pairs in a tree-like
+//               fashion, compressing after every addition.
 //
 template <class MPSType>
 MPSType
 sum(std::vector<MPSType> const& terms, 
     Args const& args = Args::global());
 
+//
+// Direct sum of a set of MPS's or MPO's: the link
+// dimensions of the result are the sums of those of
+// the terms, and no truncation is done
+//
+template <class MPSType>
+MPSType
+directSum(std::vector<MPSType> const& terms);
+
+//
+// Variationally fit res to the sum of terms with "Nsweep"
+// two-site sweeps, truncating with the usual args
+// (res provides the starting state)
+//
+template <class MPSType>
+void
+fitSum(std::vector<MPSType> const& terms,
+       MPSType & res,
+       Args const& args = Args::global());
+
+//
+// Draw nsample configurations of the sites from the
+// distribution |<s_1 s_2 ... s_N|psi>|^2 / <psi|psi>.
+// Configuration k is returned as res[k][j-1] = value
+// (1,2,...,dim) of site index j.
+//
+// Samples are drawn in batches of "BatchSize" (default 256),
+// the batches running in parallel with independent random
+// streams seeded from "Seed" (default: from the global RNG,
+// see seedRNG).
+//
+std::vector<std::vector<int>>
+sample(MPS const& psi,
+       int nsample,
+       Args const& args = Args::global());
+
+namespace detail {
+
+//Index j of the state drawn by sample, the first with
+//u < prob[0]+...+prob[j] where u = r*(prob[0]+...) for
+//r uniform in [0,1). If rounding puts u past the sum,
+//the last j with prob[j] > 0 is returned, never one
+//of zero probability.
+long
+drawState(std::vector<Real> const& prob,
+          Real u);
+
+} //namespace detail
+
     
 //
 //  Try and verify the SiteSet and MPS are mutually consistent.
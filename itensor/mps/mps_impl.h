@@ -23,6 +23,15 @@ Spectrum MPS::
 svdBond(int b, ITensor const& AA, Direction dir, 
         BigMatrixT const& PH, Args args)
     {
+    return svdBond(b,AA,dir,PH,svdBondTruncateOptions(args),args);
+    }
+
+template <typename BigMatrixT>
+Spectrum MPS::
+svdBond(int b, ITensor const& AA, Direction dir, 
+        BigMatrixT const& PH, TruncateOptions const& opts,
+        Args const& args)
+    {
     setBond(b);
     if(dir == Fromleft && b-1 > leftLim())
         {
@@ -36,10 +45,7 @@ svdBond(int b, ITensor const& AA, Direction dir,
         }
 
     auto noise = args.getReal("Noise",0.);
-    auto cutoff = args.getReal("Cutoff",MIN_CUT);
     auto usesvd = args.getBool("UseSVD",false);
-    // Truncate blocks of degenerate singular values
-    args.add("RespectDegenerate",args.getBool("RespectDegenerate",true));
 
     Spectrum res;
 
@@ -47,12 +53,12 @@ svdBond(int b, ITensor const& AA, Direction dir,
     // be put back onto the newly introduced link index
     auto original_link_tags = tags(linkIndex(*this,b));
 
-    if(usesvd || (noise == 0 && cutoff < 1E-12))
+    if(usesvd || (noise == 0 && opts.cutoff < 1E-12))
         {
         //Need high accuracy, use svd which calls the
         //accurate SVD method in the MatrixRef library
         ITensor D;
-        res = svd(AA,A_[b],D,A_[b+1],args);
+        res = svd(AA,A_[b],D,A_[b+1],opts,args);
         //Normalize the ortho center if requested
         if(args.getBool("DoNormalize",false))
             {
@@ -68,7 +74,7 @@ svdBond(int b, ITensor const& AA, Direction dir,
         //If we don't need extreme accuracy
         //or need to use noise term
         //use density matrix approach
-        res = denmatDecomp(AA,A_[b],A_[b+1],dir,PH,args);
+        res = denmatDecomp(AA,A_[b],A_[b+1],dir,PH,opts,args);
         //Normalize the ortho center if requested
         if(args.getBool("DoNormalize",false))
             {
@@ -18,6 +18,7 @@
 #include "itensor/mps/localop.h"
 #include "itensor/util/print_macro.h"
 #include "itensor/tensor/slicemat.h"
+#include <random>
 
 namespace itensor {
 
@@ -92,6 +93,172 @@ plussers(Index const& l1,
         }
     }
 
+//
+// Direct sum of the indices ls into sumind, with embed[k]
+// mapping ls[k] into its subspace of sumind
+//
+void 
+plussers(vector<Index> const& ls, 
+         Index          & sumind, 
+         vector<ITensor> & embed)
+    {
+    auto Nt = ls.size();
+    embed.resize(Nt);
+    auto qns = false;
+    for(auto& l : ls) qns = qns || hasQNs(l);
+    if(not qns)
+        {
+        long m = 0;
+        for(auto& l : ls) m += dim(l);
+        if(m <= 0) m = 1;
+        sumind = Index(m,tags(sumind));
+
+        long offset = 0;
+        for(auto k : range(Nt))
+            {
+            auto S = Matrix(dim(ls[k]),dim(sumind));
+            for(auto i : range(dim(ls[k])))
+                {
+                S(i,offset+i) = 1;
+                }
+            embed[k] = matrixITensor(std::move(S),ls[k],sumind);
+            offset += dim(ls[k]);
+            }
+        }
+    else
+        {
+        auto siq = Index::qnstorage{};
+        for(auto& l : ls)
+        for(auto n : range1(nblock(l)))
+            {
+            siq.emplace_back(qn(l,n),blocksize(l,n));
+            }
+#ifdef DEBUG
+        if(siq.empty()) Error("siq is empty in plussers");
+#endif
+        sumind = Index(std::move(siq),
+                       dir(sumind),
+                       tags(sumind));
+        int n = 1;
+        for(auto k : range(Nt))
+            {
+            auto& l = ls[k];
+            embed[k] = ITensor(dag(l),sumind);
+            for(auto j : range1(nblock(l)))
+                {
+                auto D = Tensor(blocksize(l,j),blocksize(sumind,n));
+                auto minsize = std::min(D.extent(0),D.extent(1));
+                for(auto i : range(minsize)) D(i,i) = 1.0;
+                getBlock<Real>(embed[k],{j,n}) &= D;
+                ++n;
+                }
+            }
+        }
+    }
+
+template <typename MPSType>
+MPSType
+directSum(vector<MPSType> const& terms)
+    {
+    if(terms.empty()) Error("directSum: no terms");
+    auto N = length(terms.front());
+    auto Nt = terms.size();
+    for(auto& t : terms) if(length(t) != N) Error("directSum: mismatched lengths");
+
+    //embed[i][k] maps link i of term k into link i of the sum
+    auto embed = vector<vector<ITensor>>(N);
+    for(auto i : range1(N-1))
+        {
+        auto ls = stdx::reserve_vector<Index>(Nt);
+        for(auto& t : terms) ls.push_back(linkIndex(t,i));
+        auto r = ls.front();
+        plussers(ls,r,embed[i]);
+        }
+
+    auto res = terms.front();
+    for(auto i : range1(N))
+        {
+        ITensor A;
+        for(auto k : range(Nt))
+            {
+            auto T = terms[k](i);
+            if(i > 1) T *= dag(embed[i-1][k]);
+            if(i < N) T *= embed[i][k];
+            if(k == 0) A = std::move(T);
+            else       A += T;
+            }
+        res.ref(i) = std::move(A);
+        }
+    res.leftLim(0);
+    res.rightLim(N+1);
+    return res;
+    }
+template MPS directSum<MPS>(vector<MPS> const& terms);
+template MPO directSum<MPO>(vector<MPO> const& terms);
+
+template <typename MPSType>
+void
+fitSum(vector<MPSType> const& terms,
+       MPSType & res,
+       Args const& args)
+    {
+    auto N = length(res);
+    auto Nt = terms.size();
+    auto nsweep = args.getInt("Nsweep",1);
+    auto verbose = args.getBool("Verbose",false);
+
+    res.position(1);
+    res.dag();
+    // Replace the link indices of res with similar
+    // ones so they don't clash with the links of the terms
+    res.replaceLinkInds(sim(linkInds(res)));
+
+    //E[k][n] is the environment of term k
+    auto E = vector<vector<ITensor>>(Nt,vector<ITensor>(N+2,ITensor(1.)));
+#pragma omp parallel for schedule(dynamic)
+    for(size_t k = 0; k < Nt; ++k)
+        {
+        for(auto n = N; n > 2; --n) E[k][n] = E[k][n+1]*terms[k](n)*res(n);
+        }
+
+    auto lwf = vector<ITensor>(Nt),
+         rwf = vector<ITensor>(Nt),
+         wf = vector<ITensor>(Nt);
+    for(auto sw : range1(nsweep))
+        {
+        for(int b = 1, ha = 1; ha <= 2; sweepnext(b,ha,N))
+            {
+#pragma omp parallel for schedule(dynamic)
+            for(size_t k = 0; k < Nt; ++k)
+                {
+                lwf[k] = E[k][b-1]*terms[k](b);
+                rwf[k] = E[k][b+2]*terms[k](b+1);
+                wf[k] = lwf[k]*rwf[k];
+                }
+            auto phi = wf.front();
+            for(auto k : range(1,Nt)) phi += wf[k];
+            phi.dag();
+
+            auto spec = res.svdBond(b,phi,(ha==1?Fromleft:Fromright),args);
+            if(verbose)
+                {
+                printfln("Sweep=%d, HS=%d, Bond=(%d,%d) Trunc. err=%.1E, States kept=%s",
+                         sw,ha,b,b+1,spec.truncerr(),showDim(linkIndex(res,b)));
+                }
+
+#pragma omp parallel for schedule(dynamic)
+            for(size_t k = 0; k < Nt; ++k)
+                {
+                if(ha == 1) E[k][b] = lwf[k]*res(b);
+                else        E[k][b+1] = rwf[k]*res(b+1);
+                }
+            }
+        }
+    res.dag();
+    }
+template void fitSum<MPS>(vector<MPS> const& terms, MPS & res, Args const& args);
+template void fitSum<MPO>(vector<MPO> const& terms, MPO & res, Args const& args);
+
 //
 // Adds two MPSs but doesn't attempt to
 // orthogonalize them first
@@ -251,4 +418,214 @@ totalQN(MPS const& psi)
     return tq;
     }
 
+namespace detail {
+
+Real inline
+asScalar(Real x, Real) { return x; }
+Real inline
+asScalar(Cplx z, Real) { return z.real(); }
+Cplx inline
+asScalar(Real x, Cplx) { return x; }
+Cplx inline
+asScalar(Cplx z, Cplx) { return z; }
+
+//Site tensor n of psi as a matrix with rows labeled by
+//the left link and columns by (site,right link), the
+//site index varying fastest
+template<typename T>
+Mat<T>
+samplingMatrix(MPS const& psi, int n)
+    {
+    auto N = length(psi);
+    auto A = removeQNs(psi(n));
+    auto s = removeQNs(siteIndex(psi,n));
+    auto is = std::vector<Index>{};
+    long ml = 1,
+         mr = 1;
+    if(n > 1) 
+        {
+        is.push_back(removeQNs(linkIndex(psi,n-1)));
+        ml = dim(is.back());
+        }
+    is.push_back(s);
+    if(n < N) 
+        {
+        is.push_back(removeQNs(linkIndex(psi,n)));
+        mr = dim(is.back());
+        }
+    A.permute(IndexSet(is));
+    auto M = Mat<T>(ml,dim(s)*mr);
+    auto p = M.data();
+    A.visit([&p](auto x) { *(p++) = asScalar(x,T{}); });
+    return M;
+    }
+
+//Offsets of the QN blocks of a link in the dense
+//ordering (a single block if there are no QNs)
+std::vector<long>
+blockOffsets(Index const& l)
+    {
+    auto offs = std::vector<long>{0};
+    if(not hasQNs(l))
+        {
+        offs.push_back(dim(l));
+        return offs;
+        }
+    for(auto b : range1(nblock(l))) offs.push_back(offs.back()+blocksize(l,b));
+    return offs;
+    }
+
+long
+drawState(std::vector<Real> const& prob,
+          Real u)
+    {
+    long last = 0;
+    for(auto j : range(prob.size()))
+        {
+        if(prob[j] <= 0.) continue;
+        last = j;
+        u -= prob[j];
+        if(u < 0) break;
+        }
+    return last;
+    }
+
+//Draw samples [first,first+count) into configs
+template<typename T>
+void
+sampleBatch(std::vector<Mat<T>> const& A,
+            std::vector<std::vector<long>> const& offs,
+            std::vector<long> const& d,
+            size_t first,
+            size_t count,
+            std::mt19937_64 & rng,
+            std::vector<std::vector<int>> & configs)
+    {
+    auto N = A.size();
+    auto uniform = std::uniform_real_distribution<Real>(0.,1.);
+    auto L = Mat<T>(count,1);
+    for(auto s : range(count)) L(s,0) = 1.;
+    //QN block of the left link holding each sample's amplitudes
+    auto blk = std::vector<long>(count,0);
+    auto prob = std::vector<Real>{};
+
+    for(auto n : range(N))
+        {
+        auto& An = A[n];
+        auto& lo = offs[n];
+        auto& ro = offs[n+1];
+        auto dn = d[n];
+        auto mr = ncols(An)/dn;
+        auto nL = Mat<T>(count,mr);
+        prob.resize(dn);
+
+        //Group the samples by block, so each group
+        //only needs the matching rows of An
+        auto groups = std::vector<std::vector<size_t>>(lo.size()-1);
+        for(auto s : range(count)) groups[blk[s]].push_back(s);
+
+        for(auto b : range(groups.size()))
+            {
+            auto& g = groups[b];
+            if(g.empty()) continue;
+            auto P = Mat<T>(g.size(),ncols(An));
+            if(groups.size() == 1)
+                {
+                mult(L,An,P);
+                }
+            else
+                {
+                auto bsize = lo[b+1]-lo[b];
+                auto Lg = Mat<T>(g.size(),bsize);
+                for(auto r : range(g.size()))
+                for(auto a : range(bsize))
+                    {
+                    Lg(r,a) = L(g[r],lo[b]+a);
+                    }
+                mult(Lg,subMatrix(An,lo[b],lo[b+1],0,ncols(An)),P);
+                }
+
+            for(auto r : range(g.size()))
+                {
+                auto smp = g[r];
+                auto total = 0.;
+                for(auto j : range(dn))
+                    {
+                    prob[j] = 0.;
+                    for(auto c : range(mr)) prob[j] += std::norm(P(r,j+dn*c));
+                    total += prob[j];
+                    }
+                auto j = drawState(prob,total*uniform(rng));
+                configs[first+smp][n] = 1+j;
+
+                auto fac = 1./std::sqrt(prob[j]);
+                long nzc = -1;
+                for(auto c : range(mr)) 
+                    {
+                    nL(smp,c) = fac*P(r,j+dn*c);
+                    if(nzc < 0 && nL(smp,c) != T(0)) nzc = c;
+                    }
+                //Find the block of the right link now occupied
+                auto it = std::upper_bound(ro.begin(),ro.end(),std::max(nzc,0L));
+                blk[smp] = (it-ro.begin())-1;
+                }
+            }
+        L = std::move(nL);
+        }
+    }
+
+template<typename T>
+std::vector<std::vector<int>>
+sampleImpl(MPS psi,
+           size_t nsample,
+           Args const& args)
+    {
+    auto N = length(psi);
+    auto batch = size_t(args.getInt("BatchSize",256));
+    if(batch < 1) batch = 1;
+    auto seed = args.getInt("Seed",int(Global::random()*std::numeric_limits<int>::max()));
+
+    //In this gauge the right environments are identities,
+    //so the marginals only involve the sampled sites
+    psi.position(1);
+    psi.ref(1) /= norm(psi(1));
+
+    auto A = std::vector<Mat<T>>(N);
+    auto d = std::vector<long>(N);
+    auto offs = std::vector<std::vector<long>>(N+1,std::vector<long>{0,1});
+    for(auto n : range1(N))
+        {
+        A[n-1] = samplingMatrix<T>(psi,n);
+        d[n-1] = dim(siteIndex(psi,n));
+        if(n < N) offs[n] = blockOffsets(linkIndex(psi,n));
+        }
+
+    auto configs = std::vector<std::vector<int>>(nsample,std::vector<int>(N));
+    auto nbatch = (nsample+batch-1)/batch;
+#pragma omp parallel for schedule(dynamic)
+    for(size_t nb = 0; nb < nbatch; ++nb)
+        {
+        //Each batch has its own random stream, so the
+        //samples do not depend on the number of threads
+        std::seed_seq sseq{long(seed),long(nb)};
+        std::mt19937_64 rng(sseq);
+        auto first = nb*batch;
+        auto count = std::min(batch,nsample-first);
+        sampleBatch(A,offs,d,first,count,rng,configs);
+        }
+    return configs;
+    }
+
+} //namespace detail
+
+std::vector<std::vector<int>>
+sample(MPS const& psi,
+       int nsample,
+       Args const& args)
+    {
+    if(nsample <= 0) return {};
+    if(isComplex(psi)) return detail::sampleImpl<Cplx>(psi,nsample,args);
+    return detail::sampleImpl<Real>(psi,nsample,args);
+    }
+
 } //namespace itensor
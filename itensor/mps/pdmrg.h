@@ -0,0 +1,415 @@
+//
+// Copyright 2018 The Simons Foundation, Inc. - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef __ITENSOR_PDMRG_H
+#define __ITENSOR_PDMRG_H
+
+#include "itensor/util/parallel.h"
+#include "itensor/mps/dmrg.h"
+
+//
+// Real-space parallel DMRG
+// (E.M. Stoudenmire and S.R. White, Phys. Rev. B 87, 155137 (2013)).
+//
+// The sites of the MPS are divided into contiguous blocks, one
+// per MPI node. Each node only stores the MPS tensors and the
+// LocalMPO environments of its own block, plus the two environment
+// tensors which project the rest of the system onto the block.
+//
+// Neighboring blocks are glued together by the inverse
+// singular values V = 1/Lambda of the bond between them:
+//
+//   psi = [A A .. A Lambda] V [Lambda B .. B Lambda] V [Lambda B .. B]
+//
+// During a half-sweep, even nodes sweep their block from left to
+// right while odd nodes sweep right to left (and vice versa on the
+// next half-sweep). When two nodes meet at their shared boundary,
+// the node on the left receives the neighboring center tensor and
+// environment, optimizes the boundary bond using
+// phi = psi(b)*V*psi(b+1), and sends the updated tensor and
+// environment back.
+//
+// Because MPI must be available to include this header, it is
+// not included by itensor/all.h. Programs using it must be
+// compiled with an MPI compiler wrapper (such as mpicxx) and
+// run with an MPI launcher, e.g.
+//
+//   mpirun -np 4 ./myprogram
+//
+
+namespace itensor {
+
+//
+// First and last site of the block of
+// sites owned by each node (zero-indexed by rank)
+//
+std::vector<std::pair<int,int>>
+parallelBlocks(int N, int nnodes);
+
+//
+// Real-space parallel DMRG with an MPO.
+// Must be called by every node. H (including its link
+// indices) and the site indices of psi must be the same on
+// every node, for example by creating them on node 0 and
+// calling broadcast(env,sites,H). Only the copy of psi on
+// node 0 is used as the initial state. On return, every
+// node's psi holds the optimized MPS.
+//
+// Returns the ground state energy estimate
+// (averaged over the final optimization step of each node).
+// Per-bond output is only printed if Quiet=false.
+//
+Real
+pdmrg(MPS & psi,
+      MPO const& H,
+      Sweeps const& sweeps,
+      Environment const& env,
+      Args const& args = Args::global());
+
+//
+// Implementation
+//
+
+inline std::vector<std::pair<int,int>>
+parallelBlocks(int N, int nnodes)
+    {
+    if(nnodes < 1) Error("parallelBlocks: number of nodes must be positive");
+    if(N < 2*nnodes)
+        {
+        Error(format("pdmrg: need at least 2 sites per node (N=%d, nodes=%d)",N,nnodes));
+        }
+    auto blocks = std::vector<std::pair<int,int>>(nnodes);
+    auto size = N/nnodes,
+         extra = N%nnodes;
+    int s = 1;
+    for(auto n : range(nnodes))
+        {
+        auto e = s+size-1+(n < extra ? 1 : 0);
+        blocks[n] = std::make_pair(s,e);
+        s = e+1;
+        }
+    return blocks;
+    }
+
+namespace detail {
+
+struct PDMRGBlock
+    {
+    std::vector<ITensor> A; //MPS tensors of sites start..end
+    ITensor L,              //environment of sites 1..start-1
+            R,              //environment of sites end+1..N
+            V;              //inverse singular values of the
+                            //bond to the right neighbor
+    };
+
+//Extend environment E by one site (E may be null)
+inline ITensor
+growEnv(ITensor const& E, ITensor const& A, ITensor const& W)
+    {
+    auto nE = E ? E*A : A;
+    nE *= W;
+    nE *= dag(prime(A));
+    return nE;
+    }
+
+//Diagonal tensor of inverse singular values, with the
+//index arrows flipped so it contracts with U*D and D*V
+inline ITensor
+invertSingularValues(ITensor D)
+    {
+    //Singular values this small carry no weight;
+    //use the pseudo-inverse to avoid blowing them up
+    D.apply([](Real x) { return std::fabs(x) > 1E-12 ? 1./x : 0.; });
+    return dag(D);
+    }
+
+//Tags for the new indices U*D and D*V of a boundary
+//SVD, which must differ from each other
+inline TagSet
+boundaryTags(Index const& lnk, bool right)
+    {
+    auto ts = removeTags(tags(lnk),"V");
+    return right ? addTags(ts,"V") : ts;
+    }
+
+//
+// Bring psi into the block form used by pdmrg,
+// with the orthogonality center of each block at its
+// last site
+//
+inline std::vector<PDMRGBlock>
+pdmrgSetup(MPS psi,
+           MPO const& H,
+           std::vector<std::pair<int,int>> const& blocks)
+    {
+    auto N = length(psi);
+    auto nnodes = blocks.size();
+    auto res = std::vector<PDMRGBlock>(nnodes);
+
+    psi.position(1);
+
+    //Right environments of the right-orthogonal MPS,
+    //covering the sites after the first site of each block
+    auto Rafter = std::vector<ITensor>(nnodes);
+    auto R = ITensor();
+    auto j = nnodes-1;
+    for(int k = N; k > 1; --k)
+        {
+        if(j > 0 && k == blocks[j].first) Rafter[j] = R;
+        R = growEnv(R,psi(k),H(k));
+        if(j > 0 && k == blocks[j].first) --j;
+        }
+
+    auto L = ITensor();
+    for(auto n : range(nnodes))
+        {
+        auto s = blocks[n].first,
+             e = blocks[n].second;
+        auto& blk = res[n];
+        blk.L = L;
+        if(n+1 == nnodes)
+            {
+            psi.position(N);
+            for(auto k : range1(s,e)) blk.A.push_back(psi(k));
+            break;
+            }
+
+        psi.position(e);
+        auto lnk = linkIndex(psi,e);
+        auto U = ITensor(uniqueInds(inds(psi(e)),IndexSet(lnk)));
+        ITensor D,W;
+        svd(psi(e),U,D,W,{"LeftTags=",boundaryTags(lnk,false),
+                          "RightTags=",boundaryTags(lnk,true)});
+        for(auto k : range1(s,e-1)) blk.A.push_back(psi(k));
+        blk.A.push_back(U*D);
+        blk.V = invertSingularValues(D);
+        blk.R = growEnv(Rafter[n+1],W*psi(e+1),H(e+1));
+
+        //Move the orthogonality center to
+        //the first site of the next block
+        psi.ref(e+1) = D*W*psi(e+1);
+        psi.ref(e) = U;
+        psi.leftLim(e);
+        psi.rightLim(e+2);
+
+        for(auto k : range1(s,e)) L = growEnv(L,psi(k),H(k));
+        }
+    return res;
+    }
+
+} //namespace detail
+
+inline Real
+pdmrg(MPS & psi,
+      MPO const& H,
+      Sweeps const& sweeps,
+      Environment const& env,
+      Args const& cargs)
+    {
+    TRACE_SCOPE("pdmrg");
+
+    auto args = cargs;
+    args.add("RespectDegenerate",args.getBool("RespectDegenerate",true));
+    auto silent = args.getBool("Silent",false);
+    auto quiet = silent || args.getBool("Quiet",true);
+    args.add("DebugLevel",args.getInt("DebugLevel",0));
+    args.add("DoNormalize",true);
+
+    auto N = length(psi);
+    auto nnodes = env.nnodes();
+    auto node = env.rank();
+    auto blocks = parallelBlocks(N,nnodes);
+    auto s = blocks[node].first,
+         e = blocks[node].second;
+    bool has_left = (node > 0),
+         has_right = (node+1 < nnodes);
+
+    //
+    // Distribute the initial blocks from node 0
+    //
+    auto blk = detail::PDMRGBlock();
+    if(env.firstNode())
+        {
+        auto all = detail::pdmrgSetup(psi,H,blocks);
+        for(int n = 1; n < nnodes; ++n)
+            {
+            MailBox mailbox(env,n);
+            for(auto& A : all[n].A) mailbox.send(A);
+            mailbox.send(all[n].L);
+            mailbox.send(all[n].R);
+            mailbox.send(all[n].V);
+            }
+        blk = std::move(all[0]);
+        }
+    else
+        {
+        MailBox mailbox(env,0);
+        blk.A.resize(e-s+1);
+        for(auto& A : blk.A) mailbox.receive(A);
+        mailbox.receive(blk.L);
+        mailbox.receive(blk.R);
+        mailbox.receive(blk.V);
+        }
+
+    auto lbox = has_left ? MailBox(env,node-1) : MailBox();
+    auto rbox = has_right ? MailBox(env,node+1) : MailBox();
+
+    for(auto k : range1(s,e)) psi.ref(k) = blk.A.at(k-s);
+    auto V = std::move(blk.V);
+    auto PH = LocalMPO(H,blk.L,s-1,blk.R,e+1,args);
+    blk = detail::PDMRGBlock();
+
+    //Blocks start with their center at the last site;
+    //even nodes start by sweeping to the right
+    psi.leftLim(e-1);
+    psi.rightLim(e+1);
+    if(node%2 == 0) psi.position(s,{"Truncate",false});
+
+    Real energy = NAN;
+
+    for(int sw = 1; sw <= sweeps.nsweep(); ++sw)
+        {
+        cpu_time sw_time;
+        args.add("Sweep",sw);
+        args.add("NSweep",sweeps.nsweep());
+        args.add("Cutoff",sweeps.cutoff(sw));
+        args.add("MinDim",sweeps.mindim(sw));
+        args.add("MaxDim",sweeps.maxdim(sw));
+        args.add("Noise",sweeps.noise(sw));
+        args.add("MaxIter",sweeps.niter(sw));
+        auto dopts = DavidsonOptions(args);
+        auto topts = svdBondTruncateOptions(args);
+
+        for(int ha = 1; ha <= 2; ++ha)
+            {
+            auto to_right = ((node+ha)%2 == 1);
+
+            //
+            // Sweep the interior bonds of this block
+            //
+            for(int n = 0; n < e-s; ++n)
+                {
+                auto b = to_right ? s+n : e-1-n;
+                {
+                TRACE_SCOPE("position");
+                PH.position(b,psi);
+                }
+                auto phi = psi(b)*psi(b+1);
+                energy = davidson(PH,phi,dopts);
+                auto spec = Spectrum();
+                {
+                TRACE_SCOPE("svdBond");
+                spec = psi.svdBond(b,phi,(to_right?Fromleft:Fromright),PH,topts,args);
+                }
+                if(!quiet)
+                    {
+                    printfln("Node %d: Sweep=%d, HS=%d, Bond=%d/%d, Energy=%.14f, Trunc. err=%.1E, States kept: %s",
+                             node,sw,ha,b,(N-1),energy,spec.truncerr(),showDim(linkIndex(psi,b)));
+                    }
+                }
+
+            //
+            // Optimize the bond shared with the neighboring block
+            //
+            if(to_right && has_right)
+                {
+                TRACE_SCOPE("boundary");
+                auto psiR = rbox.receive<ITensor>();
+                auto Rnext = rbox.receive<ITensor>();
+
+                psi.ref(e+1) = psiR;
+                PH.R(e+1,Rnext);
+                PH.position(e,psi);
+
+                auto lnk = commonIndex(psi(e),V);
+                auto phi = psi(e)*V*psiR;
+                energy = davidson(PH,phi,dopts);
+
+                auto U = ITensor(uniqueInds(inds(psi(e)),IndexSet(lnk)));
+                ITensor D,W;
+                auto spec = svd(phi,U,D,W,{args,"LeftTags=",detail::boundaryTags(lnk,false),
+                                                "RightTags=",detail::boundaryTags(lnk,true)});
+                D /= norm(D);
+
+                rbox.send(D*W);
+                rbox.send(detail::growEnv(PH.L(),U,H(e)));
+
+                psi.ref(e) = U*D;
+                psi.ref(e+1) = W;
+                V = detail::invertSingularValues(D);
+                if(!quiet)
+                    {
+                    printfln("Node %d: Sweep=%d, HS=%d, Bond=%d/%d, Energy=%.14f, Trunc. err=%.1E, States kept: %s (boundary)",
+                             node,sw,ha,e,(N-1),energy,spec.truncerr(),showDim(commonIndex(D,W)));
+                    }
+                }
+            else if(!to_right && has_left)
+                {
+                TRACE_SCOPE("boundary");
+                lbox.send(psi(s));
+                lbox.send(detail::growEnv(PH.R(),psi(s+1),H(s+1)));
+                psi.ref(s) = lbox.receive<ITensor>();
+                PH.L(s,lbox.receive<ITensor>());
+                }
+
+            //Orthogonality center is now at the end of the block
+            //this half-sweep moved toward
+            psi.leftLim(to_right ? e-1 : s-1);
+            psi.rightLim(to_right ? e+1 : s+1);
+            }
+
+        if(!silent && env.firstNode())
+            {
+            auto sm = sw_time.sincemark();
+            printfln("    pdmrg sweep %d/%d energy=%.14f CPU time = %s (Wall time = %s)",
+                      sw,sweeps.nsweep(),energy,showtime(sm.time),showtime(sm.wall));
+            }
+        }
+
+    energy = allSum(env,energy)/nnodes;
+
+    //
+    // Gather the blocks on node 0, absorbing the
+    // inverse singular values into the left blocks
+    //
+    if(has_right) psi.ref(e) *= V;
+    if(env.firstNode())
+        {
+        for(int n = 1; n < nnodes; ++n)
+            {
+            MailBox mailbox(env,n);
+            for(auto k : range1(blocks[n].first,blocks[n].second))
+                {
+                psi.ref(k) = mailbox.receive<ITensor>();
+                }
+            }
+        psi.leftLim(0);
+        psi.rightLim(N+1);
+        psi.position(1);
+        psi.normalize();
+        }
+    else
+        {
+        MailBox mailbox(env,0);
+        for(auto k : range1(s,e)) mailbox.send(psi(k));
+        }
+    broadcast(env,psi);
+
+    return energy;
+    }
+
+} //namespace itensor
+
+#endif
@@ -15,6 +15,8 @@
 //
 #ifndef __ITENSOR_SITESET_H
 #define __ITENSOR_SITESET_H
+#include <mutex>
+#include <unordered_map>
 #include "itensor/itensor.h"
 #include "itensor/util/str.h"
 
@@ -83,6 +85,8 @@ class SiteSet
 
     //Get the operator indicated by
     //"opname" located at site i
+    //(operators are made once and saved, so
+    //repeated calls return copies sharing storage)
     ITensor
     op(String const& opname, int i,
        Args const& args = Args::global()) const;
@@ -124,6 +128,15 @@ class SiteSet
     void
     init(SiteStore && sites);
 
+    private:
+
+    //Construct operator without consulting the cache
+    ITensor
+    makeOp(String const& opname, int i,
+           Args const& args) const;
+
+    protected:
+
     template<typename SiteType>
     void
     readType(std::istream & s);
@@ -214,12 +227,25 @@ class GenericSite
     };
 
 
+//
+// Operators already made by SiteSet::op, keyed on
+// the site number, operator name and Args.
+// Entries share storage with the ITensors returned,
+// which are copied on write.
+//
+struct SiteOpCache
+    {
+    std::mutex mutex;
+    std::unordered_map<std::string,ITensor> ops;
+    };
+
 struct SiteStore
     {
     using sptr = std::unique_ptr<SiteBase>;
     using storage = std::vector<sptr>;
     private:
     storage sites_;
+    std::unique_ptr<SiteOpCache> cache_ = std::make_unique<SiteOpCache>();
     public:
 
     SiteStore() { }
@@ -231,6 +257,7 @@ struct SiteStore
     set(int i, SiteType && s) 
         {
         sites_.at(i) = sptr(new SiteHolder<SiteType>(std::move(s)));
+        clearOps();
         }
 
     int
@@ -267,6 +294,34 @@ struct SiteStore
         if(not sites_.at(j)) Error("Unassigned site in SiteStore");
         return sites_[j]->op(opname,args);
         }
+
+    //Look up an operator saved by saveOp;
+    //returns false if not found
+    bool
+    findOp(std::string const& key,
+           ITensor & op) const
+        {
+        std::lock_guard<std::mutex> lock(cache_->mutex);
+        auto it = cache_->ops.find(key);
+        if(it == cache_->ops.end()) return false;
+        op = it->second;
+        return true;
+        }
+
+    void
+    saveOp(std::string const& key,
+           ITensor const& op) const
+        {
+        std::lock_guard<std::mutex> lock(cache_->mutex);
+        cache_->ops.emplace(key,op);
+        }
+
+    void
+    clearOps() const
+        {
+        std::lock_guard<std::mutex> lock(cache_->mutex);
+        cache_->ops.clear();
+        }
     };
 
 
@@ -365,6 +420,23 @@ op(String const& opname,
    Args const& args) const
     { 
     if(not *this) Error("Cannot call .op(..) on default-initialized SiteSet");
+
+    //Operators depend on the site, name and args (including
+    //global args, which args falls back to) so all go in the key
+    auto key = str(i)+'\0'+opname+'\0'+args.signature();
+    if(not args.isGlobal()) key += '\0'+Args::global().signature();
+    auto res = ITensor{};
+    if(sites_->findOp(key,res)) return res;
+    res = makeOp(opname,i,args);
+    sites_->saveOp(key,res);
+    return res;
+    }
+
+ITensor inline SiteSet::
+makeOp(String const& opname, 
+       int i, 
+       Args const& args) const
+    { 
     if(opname == "Id")
         {
         auto s = si(i);
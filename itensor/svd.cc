@@ -44,41 +44,18 @@ svdImpl(ITensor const& A,
         ITensor & U, 
         ITensor & D, 
         ITensor & V,
-        Args args)
+        TruncateOptions const& opts,
+        Args const& args)
     {
-    if( args.defined("Minm") )
-      {
-      if( args.defined("MinDim") )
-        {
-        Global::warnDeprecated("Args Minm and MinDim are both defined. Minm is deprecated in favor of MinDim, MinDim will be used.");
-        }
-      else
-        {
-        Global::warnDeprecated("Arg Minm is deprecated in favor of MinDim.");
-        args.add("MinDim",args.getInt("Minm"));
-        }
-      }
-
-    if( args.defined("Maxm") )
-      {
-      if( args.defined("MaxDim") )
-        {
-        Global::warnDeprecated("Args Maxm and MaxDim are both defined. Maxm is deprecated in favor of MaxDim, MaxDim will be used.");
-        }
-      else
-        {
-        Global::warnDeprecated("Arg Maxm is deprecated in favor of MaxDim.");
-        args.add("MaxDim",args.getInt("Maxm"));
-        }
-      }
-
-    auto do_truncate = args.getBool("Truncate");
-    auto cutoff = args.getReal("Cutoff",MIN_CUT);
-    auto maxdim = args.getInt("MaxDim",MAX_DIM);
-    auto mindim = args.getInt("MinDim",1);
-    auto doRelCutoff = args.getBool("DoRelCutoff",true);
-    auto absoluteCutoff = args.getBool("AbsoluteCutoff",false);
-    auto show_eigs = args.getBool("ShowEigs",false);
+    TRACE_SCOPE("svd");
+
+    auto do_truncate = opts.truncate;
+    auto cutoff = opts.cutoff;
+    auto maxdim = opts.maxdim;
+    auto mindim = opts.mindim;
+    auto doRelCutoff = opts.doRelCutoff;
+    auto absoluteCutoff = opts.absoluteCutoff;
+    auto show_eigs = opts.showEigs;
     auto litagset = getTagSet(args,"LeftTags","Link,U");
     auto ritagset = getTagSet(args,"RightTags","Link,V");
     if(litagset == ritagset) 
@@ -116,8 +93,7 @@ svdImpl(ITensor const& A,
         long m = DD.size();
         if(do_truncate)
             {
-            tie(truncerr,docut_lower,docut_upper,ndegen) = truncate(probs,maxdim,mindim,cutoff,
-                                                                    absoluteCutoff,doRelCutoff,args);
+            tie(truncerr,docut_lower,docut_upper,ndegen) = truncate(probs,opts);
             m = probs.size();
             resize(DD,m);
             reduceCols(UU,m);
@@ -239,8 +215,7 @@ svdImpl(ITensor const& A,
         int ndegen = 1;
         if(do_truncate)
             {
-            tie(truncerr,docut_lower,docut_upper,ndegen) = truncate(probs,maxdim,mindim,cutoff,
-                                                                    absoluteCutoff,doRelCutoff,args);
+            tie(truncerr,docut_lower,docut_upper,ndegen) = truncate(probs,opts);
             m = probs.size();
             alleigqn.resize(m);
             }
@@ -425,6 +400,16 @@ svdImpl(ITensor const& A,
 
 
 
+TruncateOptions
+svdTruncateDefaults()
+    {
+    auto defaults = TruncateOptions();
+    defaults.truncate = false;
+    defaults.cutoff = MIN_CUT;
+    defaults.maxdim = MAX_DIM;
+    return defaults;
+    }
+
 Spectrum 
 svdOrd2(ITensor const& A, 
         Index const& uI, 
@@ -434,32 +419,28 @@ svdOrd2(ITensor const& A,
         ITensor & V,
         Args args)
     {
-    if( args.defined("Maxm") )
-      {
-      if( args.defined("MaxDim") )
-        {
-        Global::warnDeprecated("Args Maxm and MaxDim are both defined. Maxm is deprecated in favor of MaxDim, MaxDim will be used.");
-        }
-      else
-        {
-        Global::warnDeprecated("Arg Maxm is deprecated in favor of MaxDim.");
-        args.add("MaxDim",args.getInt("Maxm"));
-        }
-      }
-
-    auto do_truncate = args.defined("Cutoff") || args.defined("MaxDim");
-    if(not args.defined("Truncate")) 
-        args.add("Truncate",do_truncate);
+    return svdOrd2(A,uI,vI,U,D,V,TruncateOptions(args,svdTruncateDefaults()),args);
+    }
 
+Spectrum 
+svdOrd2(ITensor const& A, 
+        Index const& uI, 
+        Index const& vI,
+        ITensor & U, 
+        ITensor & D, 
+        ITensor & V,
+        TruncateOptions const& opts,
+        Args const& args)
+    {
     if(A.order() != 2) 
         {
         Error("A must be matrix-like (order 2)");
         }
     if(isComplex(A))
         {
-        return svdImpl<Cplx>(A,uI,vI,U,D,V,args);
+        return svdImpl<Cplx>(A,uI,vI,U,D,V,opts,args);
         }
-    return svdImpl<Real>(A,uI,vI,U,D,V,args);
+    return svdImpl<Real>(A,uI,vI,U,D,V,opts,args);
     }
 
 } //namespace itensor
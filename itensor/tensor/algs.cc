@@ -45,6 +45,16 @@ namespace detail {
         LAPACK_INT _N = N;
         return zheev_wrapper(_N,Udata,ddata);
         }
+    int
+    hermitianDiag(int N, int k, Real *Mdata, Real *Udata, Real *ddata)
+        {
+        return dsyevr_wrapper(N,k,Mdata,ddata,Udata);
+        }
+    int
+    hermitianDiag(int N, int k, Cplx *Mdata, Cplx *Udata, Real *ddata)
+        {
+        return zheevr_wrapper(N,k,Mdata,ddata,Udata);
+        }
 
     int
     QR(int M, int N, int Rrows, Real *Qdata, Real *Rdata)
@@ -53,6 +53,25 @@ diagHermitian(MatM && M,
               MatU && U,
               Vecd && d);
 
+//
+// Only the k largest eigenvalues of M (in decreasing
+// order) and the corresponding eigenvectors, using the
+// MRRR algorithm. U is resized to have k columns.
+// Much cheaper than the full diagHermitian when k
+// is a small fraction of the size of M.
+//
+template<class MatM, class MatU,class Vecd,
+         class = stdx::require<
+         hasMatRange<MatM>,
+         hasMatRange<MatU>,
+         hasVecRange<Vecd>
+         >>
+void
+diagHermitian(MatM && M,
+              MatU && U,
+              Vecd && d,
+              long k);
+
 // compute eigenvalues
 // and right eigenvectors
 template<class MatM, class MatV,class Vecd,
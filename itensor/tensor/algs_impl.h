@@ -67,6 +67,10 @@ copyNegElts(Iter mre,
   hermitianDiag(int N, Real *Udata, Real *ddata);
   int
   hermitianDiag(int N, Cplx *Udata,Real *ddata);
+  int
+  hermitianDiag(int N, int k, Real *Mdata, Real *Udata, Real *ddata);
+  int
+  hermitianDiag(int N, int k, Cplx *Mdata, Cplx *Udata, Real *ddata);
 
   int
   QR(int M, int N, int Rrows, Real *Qdata, Real *Rdata);
@@ -138,6 +142,57 @@ diagHermitian(MatM && M,
     if(isTransposed(M)) conjugate(U);
     }
 
+template<class MatM, 
+         class MatU,
+         class Vecd,
+         class>
+void
+diagHermitian(MatM && M,
+              MatU && U,
+              Vecd && d,
+              long k)
+    {
+    using Mval = typename stdx::decay_t<MatM>::value_type;
+    using Uval = typename stdx::decay_t<MatU>::value_type;
+    static_assert((isReal<Mval>() && isReal<Uval>()) || (isCplx<Mval>() && isCplx<Uval>()),
+                  "M and U must be both real or both complex in diagHermitian");
+    auto N = ncols(M);
+    if(N < 1) throw std::runtime_error("diagHermitian: 0 dimensional matrix");
+    if(N != nrows(M))
+        {
+        printfln("M is %dx%d",nrows(M),ncols(M));
+        throw std::runtime_error("diagHermitian: Input Matrix must be square");
+        }
+    if(k < 1 || k > long(N)) throw std::runtime_error("diagHermitian: number of eigenvalues out of range");
+
+    resize(U,N,k);
+    resize(d,k);
+
+#ifdef DEBUG
+    if(!isContiguous(U))
+        throw std::runtime_error("diagHermitian: U must be contiguous");
+    if(!isContiguous(d))
+        throw std::runtime_error("diagHermitian: d must be contiguous");
+#endif
+
+    //Copy of M to be overwritten by the LAPACK routine
+    auto A = std::vector<Uval>(N*N);
+    auto m = M.cbegin();
+    for(auto& a : A) 
+        {
+        a = *m;
+        ++m;
+        }
+
+    auto info = detail::hermitianDiag(N,k,A.data(),U.data(),d.data());
+    if(info != 0) 
+        {
+        throw std::runtime_error("Error condition in diagHermitian");
+        }
+
+    if(isTransposed(M)) conjugate(U);
+    }
+
 template<typename V>
 void
 diagGeneralRef(MatRefc<V> const& M,
@@ -19,6 +19,7 @@
 
 #include "itensor/util/multalloc.h"
 #include "itensor/util/cputime.h"
+#include "itensor/util/contractprofiler.h"
 #include "itensor/detail/algs.h"
 #include "itensor/detail/gcounter.h"
 #include "itensor/tensor/mat.h"
@@ -740,6 +741,10 @@ contract(CProps const& p,
          Real beta = 0.)
     {
     using VC = common_type<VA,VB>;
+    auto profile = contractProfiler().enabled();
+    auto pstats = ContractStats{};
+    auto pstart = profile ? ContractProfiler::now() : ContractProfiler::time_point{};
+
     auto Apsize = p.permuteA() ? dim(p.newArange) : 0ul;
     auto Bpsize = p.permuteB() ? dim(p.newBrange) : 0ul;
     auto Cpsize = p.permuteC() ? dim(p.newCrange) : 0ul;
@@ -757,6 +762,8 @@ contract(CProps const& p,
         {
         auto aptr = SAFE_REINTERPRET(VA,ab);
         auto tref = makeTenRef(SAFE_PTR_GET(aptr,Apsize),Apsize,&p.newArange);
+        TRACE_SCOPE("permute");
+        ProfileLap lap(profile,pstats.t_permute);
         tref &= permute(A,p.PA);
         aref = transpose(makeMatRefc(tref.store(),p.dmid,p.dleft));
         }
@@ -777,6 +784,8 @@ contract(CProps const& p,
         {
         auto bptr = SAFE_REINTERPRET(VB,bb);
         auto tref = makeTenRef(SAFE_PTR_GET(bptr,Bpsize),Bpsize,&p.newBrange);
+        TRACE_SCOPE("permute");
+        ProfileLap lap(profile,pstats.t_permute);
         tref &= permute(B,p.PB);
         bref = makeMatRefc(tref.store(),p.dmid,p.dright);
         }
@@ -798,6 +807,14 @@ contract(CProps const& p,
         {
         auto cptr = SAFE_REINTERPRET(VC,cb);
         newC = makeTenRef(SAFE_PTR_GET(cptr,Cpsize),Cpsize,&p.newCrange);
+        if(beta != 0.)
+            {
+            //gemm adds beta times the buffer, so it
+            //must start out holding C in its order
+            TRACE_SCOPE("permute");
+            ProfileLap lap(profile,pstats.t_permute);
+            newC &= permute(makeRefc(C),inverse(p.PC));
+            }
         cref = makeMatRef(newC.store(),nrows(aref),ncols(bref));
         }
     else
@@ -812,15 +829,41 @@ contract(CProps const& p,
             }
         }
 
+    {
+    TRACE_SCOPE("gemm");
+    ProfileLap lap(profile,pstats.t_gemm);
     gemm(aref,bref,cref,alpha,beta);
+    }
 
     if(p.permuteC())
         {
 #ifdef DEBUG
         if(isTrivial(p.PC)) Error("Calling permute in contract with a trivial permutation");
 #endif
+        TRACE_SCOPE("permute");
+        ProfileLap lap(profile,pstats.t_permute);
         C &= permute(newC,p.PC);
         }
+
+    if(profile)
+        {
+        auto extents = [](auto const& T)
+            {
+            auto ds = std::vector<size_t>(T.order());
+            for(auto n : range(ds)) ds[n] = T.extent(n);
+            return ds;
+            };
+        pstats.calls = 1;
+        pstats.blocks = 1;
+        pstats.m = p.dleft;
+        pstats.n = p.dright;
+        pstats.k = p.dmid;
+        pstats.flops = flopsPerMultAdd<VA,VB>()*p.dleft*p.dright*p.dmid;
+        pstats.bytes_permuted = Apsize*sizeof(VA)+Bpsize*sizeof(VB)+Cpsize*sizeof(VC);
+        pstats.t_total = ContractProfiler::since(pstart);
+        auto sig = contractSignature(p.ai,extents(A),p.bi,extents(B),p.ci,extents(C));
+        contractProfiler().recordKernel(sig,pstats);
+        }
     }
 
 template<typename R, typename T1, typename T2>
@@ -19,7 +19,7 @@
 #include "itensor/tensor/vec.h"
 #include "itensor/util/args.h"
 #include "itensor/util/iterate.h"
-#include "itensor/detail/gcounter.h"
+#include "itensor/detail/stridedloop.h"
 
 namespace itensor {
 
@@ -263,9 +263,9 @@ contractDiagPartial(DiagElsA           const& A, Labels const& al,
             }
         }
 
-    auto bustride = IntArray(nbu,0);
-    auto custride = IntArray(nbu,0);
-    auto GC = detail::GCounter(nbu);
+    auto buext = std::vector<long>(nbu,0);
+    auto bustride = std::vector<long>(nbu,0);
+    auto custride = std::vector<long>(nbu,0);
     int n = 0;
     for(auto ib : range(bl))
         {
@@ -274,7 +274,7 @@ contractDiagPartial(DiagElsA           const& A, Labels const& al,
 #ifdef DEBUG
             if(n >= nbu) Error("n out of range");
 #endif
-            GC.setRange(n,0,B.extent(ib)-1);
+            buext[n] = B.extent(ib);
             bustride[n] = B.stride(ib);
             auto ic = find_index(cl,bl[ib]);
 #ifdef DEBUG
@@ -286,21 +286,15 @@ contractDiagPartial(DiagElsA           const& A, Labels const& al,
         }
     auto pb = MAKE_SAFE_PTR(B.data(),B.size());
     auto pc = MAKE_SAFE_PTR(C.data(),C.size());
-    for(;GC.notDone();++GC)
+    auto nA = long(A.size());
+    detail::stridedLoop(nbu,buext.data(),bustride.data(),custride.data(),
+        [&](long boffset, long coffset)
         {
-        size_t coffset = 0;
-        size_t boffset = 0;
-        for(auto i : range(nbu))
-            {
-            auto ii = GC[i];
-            boffset += ii*bustride[i];
-            coffset += ii*custride[i];
-            }
-        for(auto J : range(A))
+        for(long J = 0; J < nA; ++J)
             {
             pc[cstart+J*c_cstride+coffset] += A(J)*pb[bstart+J*b_cstride+boffset];
             }
-        }
+        });
     }
 
 // C = A*B
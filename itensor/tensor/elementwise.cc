@@ -0,0 +1,220 @@
+//
+// Copyright 2018 The Simons Foundation, Inc. - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <algorithm>
+#include <cmath>
+#include "itensor/tensor/elementwise.h"
+#include "itensor/tensor/lapack_wrap.h"
+
+//
+// ITENSOR_SIMD_CLONES makes the compiler emit one version
+// of a function per instruction set, plus a resolver which
+// picks the best one for the CPU at load time. It relies
+// on ifunc support so is only used on x86-64 Linux; elsewhere
+// the kernels are compiled once for the target given in
+// the compiler flags.
+//
+#if defined(__x86_64__) && defined(__linux__) && defined(__has_attribute)
+#if __has_attribute(target_clones)
+#define ITENSOR_SIMD_CLONES __attribute__((target_clones("avx512f","avx2","default")))
+#define ITENSOR_SIMD_DISPATCH
+#endif
+#endif
+#ifndef ITENSOR_SIMD_CLONES
+#define ITENSOR_SIMD_CLONES
+#endif
+
+namespace itensor {
+
+namespace detail {
+
+//
+// Kernels for a single chunk, vectorized for each of the
+// targets above (the Makefile compiles this file with
+// -fopenmp-simd so the simd pragmas apply even without
+// OpenMP). Complex numbers are treated as pairs of reals.
+//
+
+ITENSOR_SIMD_CLONES void
+axpyChunk(long n,
+          Real alpha,
+          Real const* __restrict x,
+          Real * __restrict y)
+    {
+#pragma omp simd
+    for(long i = 0; i < n; ++i) y[i] += alpha*x[i];
+    }
+
+ITENSOR_SIMD_CLONES void
+axpyRealCplxChunk(long n,
+                  Real alpha,
+                  Real const* __restrict x,
+                  Real * __restrict y)
+    {
+#pragma omp simd
+    for(long i = 0; i < n; ++i) y[2*i] += alpha*x[i];
+    }
+
+ITENSOR_SIMD_CLONES void
+scalChunk(long n,
+          Real alpha,
+          Real * __restrict x)
+    {
+#pragma omp simd
+    for(long i = 0; i < n; ++i) x[i] *= alpha;
+    }
+
+ITENSOR_SIMD_CLONES void
+scalCplxChunk(long n,
+              Real ar,
+              Real ai,
+              Real * __restrict x)
+    {
+#pragma omp simd
+    for(long i = 0; i < n; ++i)
+        {
+        auto xr = x[2*i],
+             xi = x[2*i+1];
+        x[2*i]   = ar*xr-ai*xi;
+        x[2*i+1] = ar*xi+ai*xr;
+        }
+    }
+
+ITENSOR_SIMD_CLONES void
+conjChunk(long n,
+          Real * __restrict x)
+    {
+#pragma omp simd
+    for(long i = 0; i < n; ++i) x[2*i+1] = -x[2*i+1];
+    }
+
+ITENSOR_SIMD_CLONES Real
+sumSqrChunk(long n,
+            Real const* __restrict x)
+    {
+    auto s = 0.;
+#pragma omp simd reduction(+:s)
+    for(long i = 0; i < n; ++i) s += x[i]*x[i];
+    return s;
+    }
+
+//
+// Call f(begin,end) over consecutive chunks of [0,n),
+// running the chunks on separate threads when n is large
+//
+template<typename F>
+void
+forChunks(long n, F const& f)
+    {
+    auto nchunk = (n+elementwiseParallelSize-1)/elementwiseParallelSize;
+    if(nchunk <= 1)
+        {
+        f(0,n);
+        return;
+        }
+#pragma omp parallel for schedule(static)
+    for(long c = 0; c < nchunk; ++c)
+        {
+        auto b = c*elementwiseParallelSize;
+        f(b,std::min(n,b+elementwiseParallelSize));
+        }
+    }
+
+} //namespace detail
+
+void
+axpyKernel(long n,
+           Real alpha,
+           Real const* x,
+           Real * y)
+    {
+    detail::forChunks(n,[=](long b, long e){ detail::axpyChunk(e-b,alpha,x+b,y+b); });
+    }
+
+void
+axpyKernel(long n,
+           Real alpha,
+           Real const* x,
+           Cplx * y)
+    {
+    auto yr = reinterpret_cast<Real*>(y);
+    detail::forChunks(n,[=](long b, long e){ detail::axpyRealCplxChunk(e-b,alpha,x+b,yr+2*b); });
+    }
+
+void
+scalKernel(long n,
+           Real alpha,
+           Real * x)
+    {
+    detail::forChunks(n,[=](long b, long e){ detail::scalChunk(e-b,alpha,x+b); });
+    }
+
+void
+scalKernel(long n,
+           Cplx alpha,
+           Cplx * x)
+    {
+    auto xr = reinterpret_cast<Real*>(x);
+    auto ar = alpha.real(),
+         ai = alpha.imag();
+    detail::forChunks(n,[=](long b, long e){ detail::scalCplxChunk(e-b,ar,ai,xr+2*b); });
+    }
+
+void
+conjKernel(long n,
+           Cplx * x)
+    {
+    auto xr = reinterpret_cast<Real*>(x);
+    detail::forChunks(n,[=](long b, long e){ detail::conjChunk(e-b,xr+2*b); });
+    }
+
+Real
+nrm2Kernel(long n,
+           Real const* x)
+    {
+    if(n <= 0) return 0.;
+    auto nchunk = (n+elementwiseParallelSize-1)/elementwiseParallelSize;
+    auto s = 0.;
+    if(nchunk <= 1)
+        {
+        s = detail::sumSqrChunk(n,x);
+        }
+    else
+        {
+#pragma omp parallel for schedule(static) reduction(+:s)
+        for(long c = 0; c < nchunk; ++c)
+            {
+            auto b = c*elementwiseParallelSize;
+            s += detail::sumSqrChunk(std::min(n,b+elementwiseParallelSize)-b,x+b);
+            }
+        }
+    //The sum of squares can overflow or underflow where the
+    //norm itself would not: redo those cases with BLAS,
+    //which rescales the elements as it goes
+    if(not std::isfinite(s) || s < 1E-250) return dnrm2_wrapper(n,x);
+    return std::sqrt(s);
+    }
+
+const char*
+elementwiseISA()
+    {
+#ifdef ITENSOR_SIMD_DISPATCH
+    if(__builtin_cpu_supports("avx512f")) return "avx512f";
+    if(__builtin_cpu_supports("avx2")) return "avx2";
+#endif
+    return "default";
+    }
+
+} //namespace itensor
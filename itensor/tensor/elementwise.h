@@ -0,0 +1,80 @@
+//
+// Copyright 2018 The Simons Foundation, Inc. - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef __ITENSOR_ELEMENTWISE_H
+#define __ITENSOR_ELEMENTWISE_H
+
+#include "itensor/types.h"
+
+//
+// Element-wise kernels on contiguous storage, used by
+// the storage types for +=, scaling, norms and conj.
+//
+// On x86-64 Linux each kernel is compiled for AVX-512,
+// AVX2 and baseline x86-64, and the version matching
+// the CPU is selected the first time it is called.
+// Arrays of more than elementwiseParallelSize elements
+// are split into chunks handled by separate OpenMP
+// threads (if ITensor is compiled with OpenMP).
+//
+
+namespace itensor {
+
+long constexpr elementwiseParallelSize = 1l << 17;
+
+//y[i] += alpha*x[i] for i = 0,1,...,n-1
+void
+axpyKernel(long n,
+           Real alpha,
+           Real const* x,
+           Real * y);
+
+//y[i] += alpha*x[i] for i = 0,1,...,n-1
+void
+axpyKernel(long n,
+           Real alpha,
+           Real const* x,
+           Cplx * y);
+
+//x[i] *= alpha for i = 0,1,...,n-1
+void
+scalKernel(long n,
+           Real alpha,
+           Real * x);
+
+//x[i] *= alpha for i = 0,1,...,n-1
+void
+scalKernel(long n,
+           Cplx alpha,
+           Cplx * x);
+
+//x[i] = conj(x[i]) for i = 0,1,...,n-1
+void
+conjKernel(long n,
+           Cplx * x);
+
+//Square root of the sum of |x[i]|^2
+Real
+nrm2Kernel(long n,
+           Real const* x);
+
+//Name of the instruction set used by the kernels
+//on this machine: "avx512f", "avx2" or "default"
+const char*
+elementwiseISA();
+
+} //namespace itensor
+
+#endif
@@ -13,11 +13,197 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 //
+#include <algorithm>
+#include <complex>
+#include <vector>
 #include "itensor/tensor/lapack_wrap.h"
 //#include "itensor/tensor/permutecplx.h"
 
 namespace itensor {
 
+namespace {
+
+thread_local bool gemm_single_precision = false;
+
+//Products with fewer multiply-adds than this are left in
+//double precision, the conversion costing more than it saves
+const double gemm_single_min = 32.*32.*32.;
+
+bool
+useSinglePrecision(LAPACK_INT m,
+                   LAPACK_INT n,
+                   LAPACK_INT k)
+    {
+    return gemm_single_precision
+           && double(m)*double(n)*double(k) >= gemm_single_min;
+    }
+
+//
+// C = A*B in single precision
+//
+void
+gemmF(bool transa,
+      bool transb,
+      LAPACK_INT m,
+      LAPACK_INT n,
+      LAPACK_INT k,
+      float const* A,
+      float const* B,
+      float * C)
+    {
+    LAPACK_INT lda = transa ? k : m,
+               ldb = transb ? n : k;
+    float alpha = 1.,
+          beta = 0.;
+#ifdef ITENSOR_USE_CBLAS
+    auto at = transa ? CblasTrans : CblasNoTrans,
+         bt = transb ? CblasTrans : CblasNoTrans;
+    cblas_sgemm(CblasColMajor,at,bt,m,n,k,alpha,A,lda,B,ldb,beta,C,m);
+#else
+    char at = transa ? 'T' : 'N',
+         bt = transb ? 'T' : 'N';
+    F77NAME(sgemm)(&at,&bt,&m,&n,&k,&alpha,const_cast<float*>(A),&lda,
+                   const_cast<float*>(B),&ldb,&beta,C,&m);
+#endif
+    }
+
+void
+gemmF(bool transa,
+      bool transb,
+      LAPACK_INT m,
+      LAPACK_INT n,
+      LAPACK_INT k,
+      std::complex<float> const* A,
+      std::complex<float> const* B,
+      std::complex<float> * C)
+    {
+    LAPACK_INT lda = transa ? k : m,
+               ldb = transb ? n : k;
+    std::complex<float> alpha = 1.,
+                        beta = 0.;
+    auto* pA = reinterpret_cast<float*>(const_cast<std::complex<float>*>(A));
+    auto* pB = reinterpret_cast<float*>(const_cast<std::complex<float>*>(B));
+    auto* pC = reinterpret_cast<float*>(C);
+    auto* palpha = reinterpret_cast<float*>(&alpha);
+    auto* pbeta = reinterpret_cast<float*>(&beta);
+#ifdef ITENSOR_USE_CBLAS
+    auto at = transa ? CblasTrans : CblasNoTrans,
+         bt = transb ? CblasTrans : CblasNoTrans;
+    cblas_cgemm(CblasColMajor,at,bt,m,n,k,palpha,pA,lda,pB,ldb,pbeta,pC,m);
+#else
+    char at = transa ? 'T' : 'N',
+         bt = transb ? 'T' : 'N';
+    F77NAME(cgemm)(&at,&bt,&m,&n,&k,palpha,pA,&lda,pB,&ldb,pbeta,pC,&m);
+#endif
+    }
+
+//
+// C = alpha*A*B + beta*C with the product A*B
+// computed in single precision
+//
+template<typename T, typename F>
+void
+gemmSingle(bool transa,
+           bool transb,
+           LAPACK_INT m,
+           LAPACK_INT n,
+           LAPACK_INT k,
+           T alpha,
+           T const* A,
+           T const* B,
+           T beta,
+           T * C)
+    {
+    auto Af = std::vector<F>(A,A+size_t(m)*k);
+    auto Bf = std::vector<F>(B,B+size_t(k)*n);
+    auto ABf = std::vector<F>(size_t(m)*n);
+    gemmF(transa,transb,m,n,k,Af.data(),Bf.data(),ABf.data());
+    //C is not read when beta == 0, following gemm
+    if(beta == T(0.))
+        {
+        for(size_t i = 0; i < ABf.size(); ++i) C[i] = alpha*T(ABf[i]);
+        }
+    else
+        {
+        for(size_t i = 0; i < ABf.size(); ++i) C[i] = alpha*T(ABf[i]) + beta*C[i];
+        }
+    }
+
+//
+// Work arrays of the eigenvalue and SVD routines,
+// kept per thread and only ever grown, so that repeated
+// decompositions (as in a DMRG sweep) do not reallocate
+//
+struct LapackWork
+    {
+    std::vector<LAPACK_REAL> real;
+    std::vector<LAPACK_REAL> rwork;
+    std::vector<LAPACK_COMPLEX> cplx;
+    std::vector<LAPACK_INT> iwork;
+    };
+
+LapackWork&
+lapackWork()
+    {
+    thread_local LapackWork w;
+    return w;
+    }
+
+template<typename T>
+T*
+growTo(std::vector<T> & v,
+       LAPACK_INT size)
+    {
+    if(v.size() < size_t(size)) v.resize(size);
+    return v.data();
+    }
+
+//Workspace size returned by a query call (lwork = -1)
+LAPACK_INT
+querySize(LAPACK_REAL w) { return LAPACK_INT(w)+1; }
+
+LAPACK_INT
+querySize(LAPACK_COMPLEX const& w) 
+    { 
+    return LAPACK_INT(*reinterpret_cast<LAPACK_REAL const*>(&w))+1; 
+    }
+
+//Eigenpairs come back in increasing order,
+//put them in decreasing order instead
+template<typename T>
+void
+reverseEigs(LAPACK_INT N,
+            LAPACK_INT k,
+            LAPACK_REAL * d,
+            T * Z)
+    {
+    for(LAPACK_INT a = 0, b = k-1; a < b; ++a, --b)
+        {
+        std::swap(d[a],d[b]);
+        std::swap_ranges(Z+a*N,Z+(a+1)*N,Z+b*N);
+        }
+    }
+
+} //namespace
+
+void
+releaseLapackWorkspace()
+    {
+    lapackWork() = LapackWork();
+    }
+
+bool
+gemmSinglePrecision() 
+    { 
+    return gemm_single_precision; 
+    }
+
+void
+gemmSinglePrecision(bool val) 
+    { 
+    gemm_single_precision = val; 
+    }
+
 //
 // daxpy
 // Y += alpha*X
@@ -125,6 +311,11 @@ gemm_wrapper(bool transa,
              LAPACK_REAL beta,
              LAPACK_REAL * C)
     {
+    if(useSinglePrecision(m,n,k))
+        {
+        gemmSingle<LAPACK_REAL,float>(transa,transb,m,n,k,alpha,A,B,beta,C);
+        return;
+        }
     LAPACK_INT lda = m,
                ldb = k;
 #ifdef ITENSOR_USE_CBLAS
@@ -175,6 +366,11 @@ gemm_wrapper(bool transa,
              Cplx beta,
              Cplx* C)
     {
+    if(useSinglePrecision(m,n,k))
+        {
+        gemmSingle<Cplx,std::complex<float>>(transa,transb,m,n,k,alpha,A,B,beta,C);
+        return;
+        }
     LAPACK_INT lda = m,
                ldb = k;
 #ifdef PLATFORM_openblas
@@ -327,21 +523,21 @@ dsyev_wrapper(char jobz,        //if jobz=='V', compute eigs and evecs
               LAPACK_REAL* eigs, //eigenvalues on return
               LAPACK_INT& info)  //error info
     {
-    std::vector<LAPACK_REAL> work;
+    auto& work = lapackWork().real;
     LAPACK_INT lda = n;
 
 #ifdef PLATFORM_acml
     static const LAPACK_INT one = 1;
     LAPACK_INT lwork = std::max(one,3*n-1);
-    work.resize(lwork+2);
+    growTo(work,lwork+2);
     F77NAME(dsyev)(&jobz,&uplo,&n,A,&lda,eigs,work.data(),&lwork,&info,1,1);
 #else
     //Compute optimal workspace size (will be written to wkopt)
     LAPACK_INT lwork = -1; //tell dsyev to compute optimal size
     LAPACK_REAL wkopt = 0;
     F77NAME(dsyev)(&jobz,&uplo,&n,A,&lda,eigs,&wkopt,&lwork,&info);
-    lwork = LAPACK_INT(wkopt);
-    work.resize(lwork+2);
+    lwork = querySize(wkopt);
+    growTo(work,lwork);
     F77NAME(dsyev)(&jobz,&uplo,&n,A,&lda,eigs,work.data(),&lwork,&info);
 #endif
     }
@@ -373,23 +569,28 @@ zgesdd_wrapper(char *jobz,           //char* specifying how much of U, V to comp
                Cplx *vt,   //on return, unitary matrix V transpose
                LAPACK_INT *info)
     {
-    std::vector<LAPACK_COMPLEX> work;
-    std::vector<LAPACK_REAL> rwork;
-    std::vector<LAPACK_INT> iwork;
+    auto& W = lapackWork();
     auto pA = reinterpret_cast<LAPACK_COMPLEX*>(A);
     auto pU = reinterpret_cast<LAPACK_COMPLEX*>(u);
     auto pVt = reinterpret_cast<LAPACK_COMPLEX*>(vt);
     LAPACK_INT l = std::min(*m,*n),
                g = std::max(*m,*n);
-    LAPACK_INT lwork = l*l+2*l+g+100;
-    work.resize(lwork);
-    rwork.resize(5*l*(1+l));
-    iwork.resize(8*l);
+    //rwork size required by LAPACK 3.7 and later
+    growTo(W.rwork,std::max(5*l*l+5*l,2*g*l+2*l*l+l));
+    growTo(W.iwork,8*l);
+    LAPACK_INT lwork = -1;
+    LAPACK_COMPLEX wkopt;
 #ifdef PLATFORM_acml
     LAPACK_INT jobz_len = 1;
-    F77NAME(zgesdd)(jobz,m,n,pA,m,s,pU,m,pVt,&l,work.data(),&lwork,rwork.data(),iwork.data(),info,jobz_len);
+    F77NAME(zgesdd)(jobz,m,n,pA,m,s,pU,m,pVt,&l,&wkopt,&lwork,W.rwork.data(),W.iwork.data(),info,jobz_len);
+    lwork = querySize(wkopt);
+    growTo(W.cplx,lwork);
+    F77NAME(zgesdd)(jobz,m,n,pA,m,s,pU,m,pVt,&l,W.cplx.data(),&lwork,W.rwork.data(),W.iwork.data(),info,jobz_len);
 #else
-    F77NAME(zgesdd)(jobz,m,n,pA,m,s,pU,m,pVt,&l,work.data(),&lwork,rwork.data(),iwork.data(),info);
+    F77NAME(zgesdd)(jobz,m,n,pA,m,s,pU,m,pVt,&l,&wkopt,&lwork,W.rwork.data(),W.iwork.data(),info);
+    lwork = querySize(wkopt);
+    growTo(W.cplx,lwork);
+    F77NAME(zgesdd)(jobz,m,n,pA,m,s,pU,m,pVt,&l,W.cplx.data(),&lwork,W.rwork.data(),W.iwork.data(),info);
 #endif
     }
 
@@ -406,18 +607,22 @@ dgesdd_wrapper(char* jobz,           //char* specifying how much of U, V to comp
                LAPACK_REAL *vt,          //on return, unitary matrix V transpose
                LAPACK_INT *info)
     {
-    std::vector<LAPACK_REAL> work;
-    std::vector<LAPACK_INT> iwork;
-    LAPACK_INT l = std::min(*m,*n),
-               g = std::max(*m,*n);
-    LAPACK_INT lwork = l*(6 + 4*l) + g;
-    work.resize(lwork);
-    iwork.resize(8*l);
+    auto& W = lapackWork();
+    LAPACK_INT l = std::min(*m,*n);
+    growTo(W.iwork,8*l);
+    LAPACK_INT lwork = -1;
+    LAPACK_REAL wkopt = 0;
 #ifdef PLATFORM_acml
     LAPACK_INT jobz_len = 1;
-    F77NAME(dgesdd)(jobz,m,n,A,m,s,u,m,vt,&l,work.data(),&lwork,iwork.data(),info,jobz_len);
+    F77NAME(dgesdd)(jobz,m,n,A,m,s,u,m,vt,&l,&wkopt,&lwork,W.iwork.data(),info,jobz_len);
+    lwork = querySize(wkopt);
+    growTo(W.real,lwork);
+    F77NAME(dgesdd)(jobz,m,n,A,m,s,u,m,vt,&l,W.real.data(),&lwork,W.iwork.data(),info,jobz_len);
 #else
-    F77NAME(dgesdd)(jobz,m,n,A,m,s,u,m,vt,&l,work.data(),&lwork,iwork.data(),info);
+    F77NAME(dgesdd)(jobz,m,n,A,m,s,u,m,vt,&l,&wkopt,&lwork,W.iwork.data(),info);
+    lwork = querySize(wkopt);
+    growTo(W.real,lwork);
+    F77NAME(dgesdd)(jobz,m,n,A,m,s,u,m,vt,&l,W.real.data(),&lwork,W.iwork.data(),info);
 #endif
     }
 
@@ -687,24 +892,143 @@ zheev_wrapper(LAPACK_INT      N,  //number of cols of A
     std::vector<LAPACK_REAL> work(N);
     LAPACKE_zheev(LAPACK_COL_MAJOR,jobz,uplo,N,A,N,w.data());
 #else
-    LAPACK_INT lwork = std::max(one,3*N-1);//max(1, 1+6*N+2*N*N);
-    std::vector<LAPACK_COMPLEX> work(lwork);
-    std::vector<LAPACK_REAL> rwork(lwork);
+    auto& W = lapackWork();
+    growTo(W.rwork,std::max(one,3*N-2));
+    LAPACK_INT lwork = -1;
+    LAPACK_COMPLEX wkopt;
     LAPACK_INT info = 0;
     static_assert(sizeof(LAPACK_COMPLEX)==sizeof(Cplx),"LAPACK_COMPLEX and itensor::Cplx have different size");
     auto pA = reinterpret_cast<LAPACK_COMPLEX*>(A);
 #ifdef PLATFORM_acml
     LAPACK_INT jobz_len = 1;
     LAPACK_INT uplo_len = 1;
-    F77NAME(zheev)(&jobz,&uplo,&N,pA,&N,d,work.data(),&lwork,rwork.data(),&info,jobz_len,uplo_len);
+    F77NAME(zheev)(&jobz,&uplo,&N,pA,&N,d,&wkopt,&lwork,W.rwork.data(),&info,jobz_len,uplo_len);
+    lwork = std::max(one,querySize(wkopt));
+    growTo(W.cplx,lwork);
+    F77NAME(zheev)(&jobz,&uplo,&N,pA,&N,d,W.cplx.data(),&lwork,W.rwork.data(),&info,jobz_len,uplo_len);
 #else
-    F77NAME(zheev)(&jobz,&uplo,&N,pA,&N,d,work.data(),&lwork,rwork.data(),&info);
+    F77NAME(zheev)(&jobz,&uplo,&N,pA,&N,d,&wkopt,&lwork,W.rwork.data(),&info);
+    lwork = std::max(one,querySize(wkopt));
+    growTo(W.cplx,lwork);
+    F77NAME(zheev)(&jobz,&uplo,&N,pA,&N,d,W.cplx.data(),&lwork,W.rwork.data(),&info);
 #endif
 
 #endif //PLATFORM_lapacke
     return info;
     }
 
+//
+// dsyevr
+//
+LAPACK_INT
+dsyevr_wrapper(LAPACK_INT    N,  //number of cols of A
+               LAPACK_INT    k,  //number of eigenpairs to compute
+               LAPACK_REAL * A,  //symmetric matrix A
+               LAPACK_REAL * d,  //eigenvalues on return
+               LAPACK_REAL * Z)  //eigenvectors on return
+    {
+    auto& W = lapackWork();
+    char jobz = 'V';
+    char range = 'I';
+    char uplo = 'U';
+    LAPACK_REAL vl = 0,
+                vu = 0,
+                abstol = 0;
+    //Indices of the eigenvalues to compute, counting from 1
+    //in increasing order: the top k are N-k+1,...,N
+    LAPACK_INT il = N-k+1,
+               iu = N,
+               m = 0,
+               info = 0;
+    //dsyevr writes all N eigenvalues to w while working
+    auto w = growTo(W.rwork,N);
+    auto isuppz = std::vector<LAPACK_INT>(2*std::max(k,LAPACK_INT(1)));
+    LAPACK_INT lwork = -1,
+               liwork = -1,
+               iwkopt = 0;
+    LAPACK_REAL wkopt = 0;
+#ifdef PLATFORM_acml
+    F77NAME(dsyevr)(&jobz,&range,&uplo,&N,A,&N,&vl,&vu,&il,&iu,&abstol,&m,w,Z,&N,
+                    isuppz.data(),&wkopt,&lwork,&iwkopt,&liwork,&info,1,1,1);
+#else
+    F77NAME(dsyevr)(&jobz,&range,&uplo,&N,A,&N,&vl,&vu,&il,&iu,&abstol,&m,w,Z,&N,
+                    isuppz.data(),&wkopt,&lwork,&iwkopt,&liwork,&info);
+#endif
+    lwork = querySize(wkopt);
+    liwork = iwkopt;
+    auto work = growTo(W.real,lwork);
+    auto iwork = growTo(W.iwork,liwork);
+#ifdef PLATFORM_acml
+    F77NAME(dsyevr)(&jobz,&range,&uplo,&N,A,&N,&vl,&vu,&il,&iu,&abstol,&m,w,Z,&N,
+                    isuppz.data(),work,&lwork,iwork,&liwork,&info,1,1,1);
+#else
+    F77NAME(dsyevr)(&jobz,&range,&uplo,&N,A,&N,&vl,&vu,&il,&iu,&abstol,&m,w,Z,&N,
+                    isuppz.data(),work,&lwork,iwork,&liwork,&info);
+#endif
+    std::copy(w,w+k,d);
+    reverseEigs(N,k,d,Z);
+    return info;
+    }
+
+//
+// zheevr
+//
+LAPACK_INT
+zheevr_wrapper(LAPACK_INT    N,  //number of cols of A
+               LAPACK_INT    k,  //number of eigenpairs to compute
+               Cplx        * A,  //Hermitian matrix A
+               LAPACK_REAL * d,  //eigenvalues on return
+               Cplx        * Z)  //eigenvectors on return
+    {
+    auto& W = lapackWork();
+    char jobz = 'V';
+    char range = 'I';
+    char uplo = 'U';
+    LAPACK_REAL vl = 0,
+                vu = 0,
+                abstol = 0;
+    LAPACK_INT il = N-k+1,
+               iu = N,
+               m = 0,
+               info = 0;
+    auto pA = reinterpret_cast<LAPACK_COMPLEX*>(A);
+    auto pZ = reinterpret_cast<LAPACK_COMPLEX*>(Z);
+    //Eigenvalues are written to the front of W.real,
+    //the real workspace going after them
+    auto isuppz = std::vector<LAPACK_INT>(2*std::max(k,LAPACK_INT(1)));
+    LAPACK_INT lwork = -1,
+               lrwork = -1,
+               liwork = -1,
+               iwkopt = 0;
+    LAPACK_COMPLEX wkopt;
+    LAPACK_REAL rwkopt = 0;
+    auto w = growTo(W.real,N);
+#ifdef PLATFORM_acml
+    F77NAME(zheevr)(&jobz,&range,&uplo,&N,pA,&N,&vl,&vu,&il,&iu,&abstol,&m,w,pZ,&N,
+                    isuppz.data(),&wkopt,&lwork,&rwkopt,&lrwork,&iwkopt,&liwork,&info,1,1,1);
+#else
+    F77NAME(zheevr)(&jobz,&range,&uplo,&N,pA,&N,&vl,&vu,&il,&iu,&abstol,&m,w,pZ,&N,
+                    isuppz.data(),&wkopt,&lwork,&rwkopt,&lrwork,&iwkopt,&liwork,&info);
+#endif
+    lwork = querySize(wkopt);
+    lrwork = querySize(rwkopt);
+    liwork = iwkopt;
+    auto work = growTo(W.cplx,lwork);
+    w = growTo(W.real,N+lrwork);
+    auto rwork = w+N;
+    auto iwork = growTo(W.iwork,liwork);
+#ifdef PLATFORM_acml
+    F77NAME(zheevr)(&jobz,&range,&uplo,&N,pA,&N,&vl,&vu,&il,&iu,&abstol,&m,w,pZ,&N,
+                    isuppz.data(),work,&lwork,rwork,&lrwork,iwork,&liwork,&info,1,1,1);
+#else
+    F77NAME(zheevr)(&jobz,&range,&uplo,&N,pA,&N,&vl,&vu,&il,&iu,&abstol,&m,w,pZ,&N,
+                    isuppz.data(),work,&lwork,rwork,&lrwork,iwork,&liwork,&info);
+#endif
+    std::copy(w,w+k,d);
+    reverseEigs(N,k,d,Z);
+    return info;
+    }
+
 //
 // dsygv
 //
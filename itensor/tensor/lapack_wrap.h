@@ -242,6 +242,17 @@ void F77NAME(zgemm)(char* transa,char* transb,LAPACK_INT* m,LAPACK_INT* n,LAPACK
 
 #endif //zgemm declaration
 
+//sgemm and cgemm declarations
+#ifndef ITENSOR_USE_CBLAS
+void F77NAME(sgemm)(char*,char*,LAPACK_INT*,LAPACK_INT*,LAPACK_INT*,
+            float*,float*,LAPACK_INT*,float*,
+            LAPACK_INT*,float*,float*,LAPACK_INT*);
+//complex arguments passed as (real,imag) pairs of floats
+void F77NAME(cgemm)(char*,char*,LAPACK_INT*,LAPACK_INT*,LAPACK_INT*,
+            float*,float*,LAPACK_INT*,float*,
+            LAPACK_INT*,float*,float*,LAPACK_INT*);
+#endif
+
 //dgemv declaration
 #ifdef ITENSOR_USE_CBLAS
 void cblas_dgemv(const enum CBLAS_ORDER Order,
@@ -436,6 +447,38 @@ void F77NAME(zgeev)(char *jobvl, char *jobvr, LAPACK_INT *n, LAPACK_COMPLEX *a,
                     LAPACK_INT *info);
 #endif
 
+
+#ifdef PLATFORM_acml
+void F77NAME(dsyevr)(char *jobz, char *range, char *uplo, LAPACK_INT *n, double *a,
+                     LAPACK_INT *lda, double *vl, double *vu, LAPACK_INT *il, LAPACK_INT *iu,
+                     double *abstol, LAPACK_INT *m, double *w, double *z, LAPACK_INT *ldz,
+                     LAPACK_INT *isuppz, double *work, LAPACK_INT *lwork, LAPACK_INT *iwork,
+                     LAPACK_INT *liwork, LAPACK_INT *info, LAPACK_INT jobz_len,
+                     LAPACK_INT range_len, LAPACK_INT uplo_len);
+#else
+void F77NAME(dsyevr)(char *jobz, char *range, char *uplo, LAPACK_INT *n, double *a,
+                     LAPACK_INT *lda, double *vl, double *vu, LAPACK_INT *il, LAPACK_INT *iu,
+                     double *abstol, LAPACK_INT *m, double *w, double *z, LAPACK_INT *ldz,
+                     LAPACK_INT *isuppz, double *work, LAPACK_INT *lwork, LAPACK_INT *iwork,
+                     LAPACK_INT *liwork, LAPACK_INT *info);
+#endif
+
+
+#ifdef PLATFORM_acml
+void F77NAME(zheevr)(char *jobz, char *range, char *uplo, LAPACK_INT *n, LAPACK_COMPLEX *a,
+                     LAPACK_INT *lda, double *vl, double *vu, LAPACK_INT *il, LAPACK_INT *iu,
+                     double *abstol, LAPACK_INT *m, double *w, LAPACK_COMPLEX *z, LAPACK_INT *ldz,
+                     LAPACK_INT *isuppz, LAPACK_COMPLEX *work, LAPACK_INT *lwork, double *rwork,
+                     LAPACK_INT *lrwork, LAPACK_INT *iwork, LAPACK_INT *liwork, LAPACK_INT *info,
+                     LAPACK_INT jobz_len, LAPACK_INT range_len, LAPACK_INT uplo_len);
+#else
+void F77NAME(zheevr)(char *jobz, char *range, char *uplo, LAPACK_INT *n, LAPACK_COMPLEX *a,
+                     LAPACK_INT *lda, double *vl, double *vu, LAPACK_INT *il, LAPACK_INT *iu,
+                     double *abstol, LAPACK_INT *m, double *w, LAPACK_COMPLEX *z, LAPACK_INT *ldz,
+                     LAPACK_INT *isuppz, LAPACK_COMPLEX *work, LAPACK_INT *lwork, double *rwork,
+                     LAPACK_INT *lrwork, LAPACK_INT *iwork, LAPACK_INT *liwork, LAPACK_INT *info);
+#endif
+
 } //extern "C"
 #endif
 
@@ -509,6 +552,54 @@ gemm_wrapper(bool transa,
              Cplx beta,
              Cplx * C);
 
+//
+// Single-precision gemm mode
+//
+// When enabled, the dgemm and zgemm wrappers above
+// convert their inputs to single precision and
+// call sgemm or cgemm (for products large enough
+// that the conversion cost is negligible).
+// This roughly doubles gemm throughput at the price
+// of a relative error of order 1E-7 in the results.
+// Storage stays double precision throughout.
+// The "SinglePrecisionSweeps" argument of dmrg
+// uses this mode for its first sweeps.
+//
+// The mode is set per thread, so calculations running
+// on different threads (such as the jobs of dmrgScan)
+// do not change each other's precision. Parallel regions
+// doing gemms for the thread which starts them pass
+// its mode on to their workers with GemmPrecisionScope.
+//
+bool
+gemmSinglePrecision();
+
+void
+gemmSinglePrecision(bool val);
+
+//Sets the gemm mode of the current thread for
+//the lifetime of the object, then restores
+//the previous mode
+class GemmPrecisionScope
+    {
+    bool prev_ = false;
+    public:
+
+    explicit
+    GemmPrecisionScope(bool single)
+      : prev_(gemmSinglePrecision())
+        {
+        gemmSinglePrecision(single);
+        }
+
+    ~GemmPrecisionScope() { gemmSinglePrecision(prev_); }
+
+    GemmPrecisionScope(GemmPrecisionScope const&) = delete;
+
+    GemmPrecisionScope&
+    operator=(GemmPrecisionScope const&) = delete;
+    };
+
 //
 // dgemv - matrix*vector multiply
 //
@@ -725,6 +816,43 @@ zheev_wrapper(LAPACK_INT    N,  //number of cols of A
               Cplx        * A,  //matrix A, on return contains eigenvectors
               LAPACK_REAL * d); //eigenvalues on return
 
+//
+// dsyevr
+//
+// Largest k eigenvalues and eigenvectors of real symmetric
+// matrix A, using the MRRR algorithm. On return the first
+// k entries of d hold the eigenvalues in decreasing order
+// and the first k columns of Z the eigenvectors.
+// A is overwritten. Z must have room for N*k elements.
+//
+LAPACK_INT
+dsyevr_wrapper(LAPACK_INT    N,  //number of cols of A
+               LAPACK_INT    k,  //number of eigenpairs to compute
+               LAPACK_REAL * A,  //symmetric matrix A
+               LAPACK_REAL * d,  //eigenvalues on return
+               LAPACK_REAL * Z); //eigenvectors on return
+
+//
+// zheevr
+//
+// Largest k eigenvalues and eigenvectors of complex
+// Hermitian matrix A, as for dsyevr_wrapper
+//
+LAPACK_INT
+zheevr_wrapper(LAPACK_INT    N,  //number of cols of A
+               LAPACK_INT    k,  //number of eigenpairs to compute
+               Cplx        * A,  //Hermitian matrix A
+               LAPACK_REAL * d,  //eigenvalues on return
+               Cplx        * Z); //eigenvectors on return
+
+//
+// Work arrays of the eigenvalue and SVD wrappers
+// are kept by each thread and reused between calls.
+// Release the ones held by the calling thread.
+//
+void
+releaseLapackWorkspace();
+
 //
 // dsygv
 //
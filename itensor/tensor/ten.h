@@ -17,6 +17,7 @@
 #define __ITENSOR_TEN_H_
 
 #include "itensor/detail/algs.h"
+#include "itensor/detail/stridedloop.h"
 #include "itensor/tensor/teniter.h"
 #include "itensor/tensor/range.h"
 #include "itensor/tensor/lapack_wrap.h"
@@ -341,6 +342,18 @@ transform(TenRefc<R1,T1> const& from,
           TenRef<R2,T2>  const& to,
           Op&& op);
 
+//Same as transform, but splits large tensors over
+//OpenMP threads. op must only modify its second
+//argument and no element of to may be referenced
+//twice.
+template<typename R1, typename T1, 
+         typename R2, typename T2, 
+         typename Op>
+void
+parallelTransform(TenRefc<R1,T1> const& from, 
+                  TenRef<R2,T2>  const& to,
+                  Op&& op);
+
 template<typename V, typename range_type>
 auto
 makeTenRef(V * p,
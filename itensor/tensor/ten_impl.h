@@ -104,18 +104,20 @@ checkCompatible(TenRefc<R1,T1> const& A,
             }
     }
 
-template<typename R1, typename T1, 
+namespace detail {
+
+template<bool Parallel,
+         typename R1, typename T1, 
          typename R2, typename T2, 
          typename Op>
 void
-transform(TenRefc<R1,T1> const& from, 
-          TenRef<R2,T2>  const& to,
-          Op&& op)
+transformImpl(TenRefc<R1,T1> const& from, 
+              TenRef<R2,T2>  const& to,
+              Op&& op)
     {
 #ifdef DEBUG
     checkCompatible(to,from,"transform");
 #endif 
-    using size_type = decltype(from.extent(0));
     auto r = to.order();
     if(r == 0)
         {
@@ -123,40 +125,51 @@ transform(TenRefc<R1,T1> const& from,
         return;
         }
 
-    //find size and location of largest index of from
-    size_type bigind = 0, 
-              bigsize = from.extent(0);
-    for(decltype(r) j = 1; j < r; ++j)
-        if(bigsize < from.extent(j))
-            {
-            bigsize = from.extent(j); 
-            bigind = j;
-            }
-
-    auto stepfrom = from.stride(bigind);
-    auto stepto = to.stride(bigind);
-
-    auto RB = RangeBuilder(r);
-    for(decltype(r) i = 0; i < r; ++i)
-        RB.setIndex(i,from.extent(i));
-    //Leave bigind fixed to zero, will
-    //increment manually in the loop below
-    RB.setIndex(bigind,1);
+    auto ext = std::vector<long>(r),
+         sfrom = std::vector<long>(r),
+         sto = std::vector<long>(r);
+    for(decltype(r) j = 0; j < r; ++j)
+        {
+        ext[j] = from.extent(j);
+        sfrom[j] = from.stride(j);
+        sto[j] = to.stride(j);
+        }
 
-    for(auto& i : RB.build())
+    auto pfrom = MAKE_SAFE_PTR(from.data(),from.store().size());
+    auto pto = MAKE_SAFE_PTR(to.data(),to.store().size());
+    auto f = [&](long of, long ot) { op(pfrom[of],pto[ot]); };
+    if constexpr(Parallel)
         {
-        //println("i = ",i);
-        //printfln("to (offset,size) = (%d,%d)",offset(to,i),to.store().size());
-        //printfln("from (offset,size) = (%d,%d)",offset(from,i),from.store().size());
-        auto pto = MAKE_SAFE_PTR_OFFSET(to.data(),offset(to,i),to.store().size());
-        auto pfrom = MAKE_SAFE_PTR_OFFSET(from.data(),offset(from,i),from.store().size());
-        for(decltype(bigsize) b = 0; b < bigsize; ++b)
-            {
-            op(*pfrom,*pto);
-            pto += stepto;
-            pfrom += stepfrom;
-            }
+        parallelStridedLoop(r,ext.data(),sfrom.data(),sto.data(),f);
         }
+    else
+        {
+        stridedLoop(r,ext.data(),sfrom.data(),sto.data(),f);
+        }
+    }
+
+} //namespace detail
+
+template<typename R1, typename T1, 
+         typename R2, typename T2, 
+         typename Op>
+void
+transform(TenRefc<R1,T1> const& from, 
+          TenRef<R2,T2>  const& to,
+          Op&& op)
+    {
+    detail::transformImpl<false>(from,to,std::forward<Op>(op));
+    }
+
+template<typename R1, typename T1, 
+         typename R2, typename T2, 
+         typename Op>
+void
+parallelTransform(TenRefc<R1,T1> const& from, 
+                  TenRef<R2,T2>  const& to,
+                  Op&& op)
+    {
+    detail::transformImpl<true>(from,to,std::forward<Op>(op));
     }
 
 //Assign to referenced data
@@ -22,6 +22,7 @@
 #include "itensor/util/vararray.h"
 #include "itensor/util/vector_no_init.h"
 #include "itensor/util/timers.h"
+#include "itensor/util/trace.h"
 #include "itensor/types.h"
 
 namespace itensor {
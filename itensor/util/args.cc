@@ -50,6 +50,7 @@ Args::Val::
 Val()
     :
     name_("Null"),
+    hash_(Key::hash(name_.data(),name_.size())),
     type_(None),
     rval_(NAN)
     { }
@@ -58,6 +59,7 @@ Args::Val::
 Val(const char* name)
     :
     name_(chopSpaceEq(name)),
+    hash_(Key::hash(name_.data(),name_.size())),
     type_(Boolean),
     rval_(1.0)
     { }
@@ -66,6 +68,7 @@ Args::Val::
 Val(Name const& name)
     :
     name_(chopSpaceEq(name)),
+    hash_(Key::hash(name_.data(),name_.size())),
     type_(Boolean),
     rval_(1.0)
     { }
@@ -74,6 +77,7 @@ Args::Val::
 Val(Name const& name, bool bval)
     :
     name_(chopSpaceEq(name)),
+    hash_(Key::hash(name_.data(),name_.size())),
     type_(Boolean),
     rval_((bval ? 1.0 : 0.0))
     { }
@@ -82,6 +86,7 @@ Args::Val::
 Val(Name const& name, const char* sval)
     :
     name_(chopSpaceEq(name)),
+    hash_(Key::hash(name_.data(),name_.size())),
     type_(String),
     sval_(sval),
     rval_(NAN)
@@ -91,6 +96,7 @@ Args::Val::
 Val(Name const& name, const string& sval)
     :
     name_(chopSpaceEq(name)),
+    hash_(Key::hash(name_.data(),name_.size())),
     type_(String),
     sval_(sval),
     rval_(NAN)
@@ -100,6 +106,7 @@ Args::Val::
 Val(Name const& name, long ival)
     :
     name_(chopSpaceEq(name)),
+    hash_(Key::hash(name_.data(),name_.size())),
     type_(Numeric),
     rval_(ival)
     { }
@@ -109,6 +116,7 @@ Args::Val::
 Val(Name const& name, int ival)
     :
     name_(chopSpaceEq(name)),
+    hash_(Key::hash(name_.data(),name_.size())),
     type_(Numeric),
     rval_(ival)
     { }
@@ -117,6 +125,7 @@ Args::Val::
 Val(Name const& name, unsigned long ival)
     :
     name_(chopSpaceEq(name)),
+    hash_(Key::hash(name_.data(),name_.size())),
     type_(Numeric),
     rval_(ival)
     { }
@@ -125,6 +134,7 @@ Args::Val::
 Val(Name const& name, unsigned int ival)
     :
     name_(chopSpaceEq(name)),
+    hash_(Key::hash(name_.data(),name_.size())),
     type_(Numeric),
     rval_(ival)
     { }
@@ -133,6 +143,7 @@ Args::Val::
 Val(Name const& name, Real rval)
     :
     name_(chopSpaceEq(name)),
+    hash_(Key::hash(name_.data(),name_.size())),
     type_(Numeric),
     rval_(rval)
     { }
@@ -141,6 +152,7 @@ void Args::Val::
 read(std::istream& s)
     { 
     itensor::read(s, name_);
+    hash_ = Key::hash(name_.data(),name_.size());
     itensor::read(s, type_);
     if(type_ == String)
         itensor::read(s, sval_);
@@ -253,25 +265,17 @@ void Args::
 add(Name const& name, Real rval) { add({name,rval}); }
 
 bool Args::
-defined(Name const& name) const
+defined(Key const& name) const
     {
-    for(auto& x : vals_)
-        {
-        if(x.name() == name) return true;
-        }
-
-    if(isGlobal()) return false;
-
-    //otherwise see if global Args contains it
-    return global().defined(name);
+    return find(name) != nullptr;
     }
 
 // Remove an arg from the set - always succeeds
 void Args::
-remove(const Name& name)
+remove(Key const& name)
     {
     for(auto it = vals_.begin(); it != vals_.end(); ++it)
-        if(it->name() == name)
+        if(it->is(name))
             {
             vals_.erase(it);
             break;
@@ -283,9 +287,10 @@ void Args::
 add(Val const& val)
     {
     if(!val) return;
+    auto key = Key(val.name().c_str());
     for(auto& x : vals_)
         //If already defined, replace
-        if(x.name() == val.name()) 
+        if(x.is(key)) 
             {
             x = val;
             return;
@@ -301,85 +306,91 @@ add(const char* ostring)
     }
 
  
-const Args::Val& Args::
-get(Name const& name) const
+const Args::Val* Args::
+find(Key const& name) const
     {
     for(auto& x : vals_)
         {
-        if(x.name() == name) return x;
-        }
-    //couldn't find the Val in this Args
-    if(isGlobal())
-        {
-        throw ITError("Requested option " + name + " not found");
+        if(x.is(name)) return &x;
         }
-    return global().get(name);
+    if(isGlobal()) return nullptr;
+
+    //otherwise see if global Args contains it
+    return global().find(name);
+    }
+
+const Args::Val& Args::
+get(Key const& name) const
+    {
+    auto* v = find(name);
+    if(!v) throw ITError("Requested option " + name.str() + " not found");
+    return *v;
     }
 
 bool Args::
-getBool(Name const& name) const
+getBool(Key const& name) const
     {
     return get(name).boolVal();
     }
 
 bool Args::
-getBool(Name const& name, bool default_value) const
+getBool(Key const& name, bool default_value) const
     {
-    if(defined(name)) return get(name).boolVal();
-    return default_value;
+    auto* v = find(name);
+    return v ? v->boolVal() : default_value;
     }
 
  
 string const& Args::
-getString(Name const& name) const
+getString(Key const& name) const
     {
     return get(name).stringVal();
     }
 
 string const& Args::
-getString(Name const& name, string const& default_value) const
+getString(Key const& name, string const& default_value) const
     {
-    if(defined(name)) return get(name).stringVal();
-    return default_value;
+    auto* v = find(name);
+    return v ? v->stringVal() : default_value;
     }
 
 long Args::
-getInt(Name const& name) const
+getInt(Key const& name) const
     {
     return get(name).intVal();
     }
 
 long Args::
-getInt(Name const& name, long default_value) const
+getInt(Key const& name, long default_value) const
     {
-    if(defined(name)) return get(name).intVal();
-    return default_value;
+    auto* v = find(name);
+    return v ? v->intVal() : default_value;
     }
 
 size_t Args::
-getSizeT(Name const& name) const
+getSizeT(Key const& name) const
     {
     return get(name).size_tVal();
     }
 
 size_t Args::
-getSizeT(Name const& name, long default_value) const
+getSizeT(Key const& name, long default_value) const
     {
-    if(defined(name)) return get(name).size_tVal();
-    return default_value;
+    auto* v = find(name);
+    return v ? v->size_tVal() : default_value;
     }
 
 Real Args::
-getReal(Name const& name) const
+getReal(Key const& name) const
     {
     return get(name).realVal();
     }
 
 Real Args::
-getReal(Name const& name, Real default_value) const
+getReal(Key const& name, Real default_value) const
     {
-    if(defined(name)) return get(name).realVal();
-    return default_value;
+    auto* v = find(name);
+    return v ? v->realVal() : default_value;
     }
 
 void Args::
@@ -465,6 +476,31 @@ write(std::ostream& s) const
     itensor::write(s,vals_);
     }
 
+std::string Args::
+signature() const
+    {
+    auto sig = std::string{};
+    for(auto& v : vals_)
+        {
+        sig += v.name();
+        sig += '\0';
+        sig += char('0'+v.type());
+        if(v.type() == Val::String) 
+            {
+            sig += v.stringVal();
+            }
+        else 
+        if(v.type() != Val::None)
+            {
+            //Exact bit pattern of the stored value
+            auto r = (v.type() == Val::Boolean) ? Real(v.boolVal()) : v.realVal();
+            sig.append(reinterpret_cast<const char*>(&r),sizeof(r));
+            }
+        sig += '\0';
+        }
+    return sig;
+    }
+
 Args
 operator+(Args args, Args const& other)
     {
@@ -16,6 +16,7 @@
 #ifndef __ITENSOR_OPTION_H
 #define __ITENSOR_OPTION_H
 
+#include <cstdint>
 #include <vector>
 #include <string>
 #include "math.h"
@@ -45,6 +46,12 @@ namespace itensor {
 //   func(T1 t1, T2 t2, ..., const Args& args = Args::global());
 //   which will incur essentially no overhead.
 //   If you intend to add or modify the args set, take it by value.
+// o Names are passed as Args::Key objects, which are constructed
+//   implicitly from string literals or std::string and carry a
+//   hash of the name, so lookups compare integers rather than
+//   strings. A Key made from a string literal refers to it,
+//   while one made from a std::string keeps its own copy of
+//   the name, so it stays valid after the string is gone.
 //
 
 class Args
@@ -54,6 +61,66 @@ class Args
     using Name = std::string;
     using storage_type = InfArray<Val,7ul>;
 
+    class Key
+        {
+        const char* name_ = nullptr; //null if the name is in owned_
+        size_t size_ = 0;
+        uint64_t hash_ = 0;
+        Name owned_;
+        public:
+
+        Key(const char* name)
+          : name_(name),
+            size_(length(name)),
+            hash_(hash(name,size_))
+            { }
+
+        Key(Name const& name)
+          : size_(name.size()),
+            hash_(hash(name.data(),name.size())),
+            owned_(name)
+            { }
+
+        uint64_t
+        hashValue() const { return hash_; }
+
+        Name
+        str() const { return Name(data(),size_); }
+
+        bool
+        equals(Name const& name, uint64_t h) const
+            {
+            return h == hash_ && name.size() == size_ 
+                && name.compare(0,size_,data(),size_) == 0;
+            }
+
+        //FNV-1a hash
+        static uint64_t constexpr
+        hash(const char* s, size_t n)
+            {
+            uint64_t h = 14695981039346656037ull;
+            for(size_t i = 0; i < n; ++i)
+                {
+                h ^= static_cast<unsigned char>(s[i]);
+                h *= 1099511628211ull;
+                }
+            return h;
+            }
+
+        private:
+
+        const char*
+        data() const { return name_ ? name_ : owned_.data(); }
+
+        static size_t constexpr
+        length(const char* s)
+            {
+            size_t n = 0;
+            while(s[n] != '\0') ++n;
+            return n;
+            }
+        };
+
     Args();
 
     //
@@ -113,11 +180,11 @@ class Args
 
     // Check if a specific name is defined in this Args instance
     bool
-    defined(Name const& name) const;
+    defined(Key const& name) const;
 
     // Remove an arg from the set - always succeeds
     void
-    remove(Name const& name);
+    remove(Key const& name);
 
     //
     // Methods for getting values of named arguments
@@ -125,38 +192,38 @@ class Args
 
     // Get value of bool-type argument, throws if not defined
     bool
-    getBool(Name const& name) const;
+    getBool(Key const& name) const;
     // Get value of bool-type argument, returns default_val if not defined
     bool
-    getBool(Name const& name, bool default_val) const;
+    getBool(Key const& name, bool default_val) const;
 
     // Get value of string-type argument, throws if not defined
     const std::string&
-    getString(Name const& name) const;
+    getString(Key const& name) const;
     // Get value of string-type argument, returns default_val if not defined
     const std::string&
-    getString(Name const& name, std::string const& default_val) const;
+    getString(Key const& name, std::string const& default_val) const;
 
     // Get value of int-type argument, throws if not defined
     long
-    getInt(Name const& name) const;
+    getInt(Key const& name) const;
     // Get value of int-type argument, returns default_val if not defined
     long
-    getInt(Name const& name, long default_val) const;
+    getInt(Key const& name, long default_val) const;
 
     // Get value of int-type argument, throws if not defined
     size_t
-    getSizeT(Name const& name) const;
+    getSizeT(Key const& name) const;
     // Get value of int-type argument, returns default_val if not defined
     size_t
-    getSizeT(Name const& name, long default_val) const;
+    getSizeT(Key const& name, long default_val) const;
 
     // Get value of Real-type argument, throws if not defined
     Real
-    getReal(Name const& name) const;
+    getReal(Key const& name) const;
     // Get value of Real-type argument, returns default_val if not defined
     Real
-    getReal(Name const& name, Real default_val) const;
+    getReal(Key const& name, Real default_val) const;
 
     // Add contents of other to this
     Args&
@@ -182,6 +249,12 @@ class Args
     void
     write(std::ostream& s) const;
 
+    // Compact string determined by the names and values
+    // of the args held (not including global args),
+    // suitable as a key for caching results computed from them
+    std::string
+    signature() const;
+
     private:
 
     void
@@ -216,7 +289,11 @@ class Args
     add(Val const& v);
 
     Val const&
-    get(Name const& name) const;
+    get(Key const& name) const;
+
+    //Returns nullptr if name is not defined here or in global()
+    Val const*
+    find(Key const& name) const;
 
     friend std::ostream& 
     operator<<(std::ostream & s, Val const& v);
@@ -230,6 +307,7 @@ class Args
         enum Type { Boolean, Numeric, String, None };
         private:
         Name name_;
+        uint64_t hash_ = 0;
         Type type_;
         std::string sval_;
         Real rval_;
@@ -261,6 +339,9 @@ class Args
         Name const&
         name() const { return name_; }
 
+        bool
+        is(Key const& key) const { return key.equals(name_,hash_); }
+
         bool
         boolVal() const { assertType(Boolean); return bool(rval_); }
 
@@ -0,0 +1,253 @@
+//
+// Copyright 2018 The Simons Foundation, Inc. - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include "itensor/util/contractprofiler.h"
+#include "itensor/util/error.h"
+#include "itensor/util/print.h"
+
+using std::string;
+using std::vector;
+
+namespace itensor {
+
+namespace {
+
+using ProfileKey = std::pair<string,string>; //(source,signature)
+
+struct ProfileData
+    {
+    std::mutex mutex;
+    std::map<ProfileKey,ContractStats> stats;
+    };
+
+ProfileData&
+profileData()
+    {
+    static ProfileData data_;
+    return data_;
+    }
+
+ContractProfiler::BlockScope*&
+currentBlockScope()
+    {
+    thread_local ContractProfiler::BlockScope* current_ = nullptr;
+    return current_;
+    }
+
+char
+labelChar(long l)
+    {
+    auto n = std::abs(l);
+    if(n >= 1 && n <= 26) return 'a'+(n-1);
+    if(n > 26 && n <= 52) return 'A'+(n-27);
+    return '#';
+    }
+
+bool
+isKernelSource(string const& source)
+    {
+    return source == "Dense" || source == "QDenseBlock";
+    }
+
+} //namespace
+
+ContractStats& ContractStats::
+operator+=(ContractStats const& o)
+    {
+    calls += o.calls;
+    blocks += o.blocks;
+    flops += o.flops;
+    bytes_permuted += o.bytes_permuted;
+    t_permute += o.t_permute;
+    t_gemm += o.t_gemm;
+    t_total += o.t_total;
+    //GEMM dimensions are only meaningful for a fixed signature
+    if(m == 0) { m = o.m; n = o.n; k = o.k; }
+    return *this;
+    }
+
+ContractProfiler::
+ContractProfiler()
+  : enabled_(false)
+    {
+    auto env = std::getenv("ITENSOR_CONTRACT_PROFILE");
+    if(env && string(env) != "0") enable(true);
+    }
+
+void ContractProfiler::
+reset()
+    {
+    auto& data = profileData();
+    std::lock_guard<std::mutex> lock(data.mutex);
+    data.stats.clear();
+    }
+
+void ContractProfiler::
+record(string const& source,
+       string const& signature,
+       ContractStats const& st)
+    {
+    auto& data = profileData();
+    std::lock_guard<std::mutex> lock(data.mutex);
+    data.stats[ProfileKey(source,signature)] += st;
+    }
+
+void ContractProfiler::
+recordKernel(string const& signature,
+             ContractStats const& st)
+    {
+    auto* scope = currentBlockScope();
+    auto& data = profileData();
+    //The blocks of one scope can be recorded from several
+    //threads, so the scope is also updated under the lock
+    std::lock_guard<std::mutex> lock(data.mutex);
+    if(scope)
+        {
+        scope->add(st);
+        data.stats[ProfileKey("QDenseBlock",signature)] += st;
+        }
+    else
+        {
+        data.stats[ProfileKey("Dense",signature)] += st;
+        }
+    }
+
+vector<ContractProfileEntry> ContractProfiler::
+entries() const
+    {
+    auto res = vector<ContractProfileEntry>{};
+    {
+    auto& data = profileData();
+    std::lock_guard<std::mutex> lock(data.mutex);
+    res.reserve(data.stats.size());
+    for(auto& p : data.stats)
+        {
+        res.push_back(ContractProfileEntry{p.first.first,p.first.second,p.second});
+        }
+    }
+    std::stable_sort(res.begin(),res.end(),
+                     [](ContractProfileEntry const& a, ContractProfileEntry const& b)
+                     { return a.stats.t_total > b.stats.t_total; });
+    return res;
+    }
+
+ContractStats ContractProfiler::
+kernelTotal() const
+    {
+    auto tot = ContractStats{};
+    for(auto& e : entries())
+        {
+        if(isKernelSource(e.source)) tot += e.stats;
+        }
+    tot.m = tot.n = tot.k = 0;
+    return tot;
+    }
+
+void ContractProfiler::
+writeCSV(std::ostream& s) const
+    {
+    s << "source,signature,m,n,k,calls,blocks,flops,bytes_permuted,"
+      << "t_permute,t_gemm,t_total,gflops\n";
+    for(auto& e : entries())
+        {
+        auto& st = e.stats;
+        s << format("%s,\"%s\",%d,%d,%d,%d,%d,%.6e,%.6e,%.6e,%.6e,%.6e,%.4f\n",
+                    e.source,e.signature,st.m,st.n,st.k,st.calls,st.blocks,
+                    st.flops,st.bytes_permuted,st.t_permute,st.t_gemm,st.t_total,
+                    st.gflops());
+        }
+    }
+
+void ContractProfiler::
+writeCSV(string const& fname) const
+    {
+    std::ofstream s(fname.c_str());
+    if(!s.good()) throw ITError("Couldn't open file \"" + fname + "\" for writing");
+    writeCSV(s);
+    }
+
+ContractProfiler::BlockScope::
+BlockScope()
+    {
+    if(contractProfiler().enabled())
+        {
+        active_ = true;
+        parent_ = currentBlockScope();
+        currentBlockScope() = this;
+        start_ = now();
+        }
+    }
+
+ContractProfiler::BlockScope::
+~BlockScope()
+    {
+    if(!active_) return;
+    currentBlockScope() = parent_;
+    stats_.calls = 1;
+    stats_.m = stats_.n = stats_.k = 0;
+    stats_.t_total = since(start_);
+    contractProfiler().record("QDense",signature_,stats_);
+    }
+
+ContractProfiler::BlockScope::Worker::
+Worker(BlockScope & scope)
+    {
+    if(!scope.active()) return;
+    active_ = true;
+    prev_ = currentBlockScope();
+    currentBlockScope() = &scope;
+    }
+
+ContractProfiler::BlockScope::Worker::
+~Worker()
+    {
+    if(active_) currentBlockScope() = prev_;
+    }
+
+string
+contractSignature(Labels const& ai, vector<size_t> const& adims,
+                  Labels const& bi, vector<size_t> const& bdims,
+                  Labels const& ci, vector<size_t> const& cdims)
+    {
+    auto res = string("C[");
+    for(auto l : ci) res += labelChar(l);
+    res += "]=A[";
+    for(auto l : ai) res += labelChar(l);
+    res += "]*B[";
+    for(auto l : bi) res += labelChar(l);
+    res += "]";
+
+    //Dimension of each label, in alphabetical order
+    auto dims = std::map<char,size_t>{};
+    auto addDims = [&dims](Labels const& is, vector<size_t> const& ds)
+        {
+        for(decltype(is.size()) n = 0; n < is.size() && n < ds.size(); ++n)
+            {
+            dims[labelChar(is[n])] = ds[n];
+            }
+        };
+    addDims(ai,adims);
+    addDims(bi,bdims);
+    addDims(ci,cdims);
+    for(auto& d : dims) res += format(" %s:%d",d.first,d.second);
+    return res;
+    }
+
+} //namespace itensor
@@ -0,0 +1,235 @@
+//
+// Copyright 2018 The Simons Foundation, Inc. - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef __ITENSOR_CONTRACTPROFILER_H
+#define __ITENSOR_CONTRACTPROFILER_H
+
+#include <atomic>
+#include <chrono>
+#include <iosfwd>
+#include <string>
+#include <vector>
+#include "itensor/tensor/types.h"
+
+//
+// Runtime contraction profiler.
+//
+// When enabled (contractProfiler().enable() or the
+// environment variable ITENSOR_CONTRACT_PROFILE=1),
+// every call to the GEMM-based tensor contraction kernel
+// and every block-sparse (QDense) contraction is recorded,
+// aggregated by the shape signature of the contraction:
+//
+//   C[bc]=A[ab]*B[ac] a:4 b:10 c:10
+//
+// Rows are tagged by source:
+//   "Dense"       - contraction kernel called on dense data
+//   "QDenseBlock" - contraction kernel called on a pair of QN blocks
+//   "QDense"      - a whole block-sparse contraction, including
+//                   block matching overhead (signature uses the
+//                   total dimensions of the indices)
+//
+// Results are written as CSV with writeCSV.
+//
+
+namespace itensor {
+
+struct ContractStats
+    {
+    size_t calls = 0;
+    size_t blocks = 0;        //number of kernel calls aggregated
+    size_t m = 0,             //GEMM dimensions (kernel rows only)
+           n = 0,
+           k = 0;
+    double flops = 0.;
+    double bytes_permuted = 0.;
+    double t_permute = 0.;    //seconds
+    double t_gemm = 0.;       //seconds
+    double t_total = 0.;      //seconds
+
+    //Achieved GFLOP/s over the total time
+    double
+    gflops() const { return t_total > 0. ? 1E-9*flops/t_total : 0.; }
+
+    ContractStats&
+    operator+=(ContractStats const& o);
+    };
+
+struct ContractProfileEntry
+    {
+    std::string source;
+    std::string signature;
+    ContractStats stats;
+    };
+
+class ContractProfiler
+    {
+    std::atomic<bool> enabled_;
+    public:
+    using clock_type = std::chrono::steady_clock;
+    using time_point = clock_type::time_point;
+
+    ContractProfiler();
+
+    bool
+    enabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+    void
+    enable(bool val = true) { enabled_.store(val,std::memory_order_relaxed); }
+
+    void
+    disable() { enable(false); }
+
+    void
+    reset();
+
+    //Record a call of the contraction kernel
+    //(source is "QDenseBlock" if inside a BlockScope
+    //on the same thread, "Dense" otherwise)
+    void
+    recordKernel(std::string const& signature,
+                 ContractStats const& st);
+
+    void
+    record(std::string const& source,
+           std::string const& signature,
+           ContractStats const& st);
+
+    //All aggregated rows, sorted by decreasing total time
+    std::vector<ContractProfileEntry>
+    entries() const;
+
+    //Sum over kernel rows ("Dense" and "QDenseBlock")
+    ContractStats
+    kernelTotal() const;
+
+    void
+    writeCSV(std::ostream& s) const;
+
+    void
+    writeCSV(std::string const& fname) const;
+
+    static time_point
+    now() { return clock_type::now(); }
+
+    static double
+    since(time_point t0)
+        {
+        return std::chrono::duration<double>(clock_type::now()-t0).count();
+        }
+
+    //
+    // Groups the kernel calls made for the blocks of
+    // one block-sparse contraction and records the
+    // aggregate as a "QDense" row when destroyed
+    //
+    class BlockScope
+        {
+        BlockScope* parent_ = nullptr;
+        time_point start_;
+        std::string signature_;
+        ContractStats stats_;
+        bool active_ = false;
+        public:
+
+        BlockScope();
+
+        BlockScope(BlockScope const&) = delete;
+        BlockScope& operator=(BlockScope const&) = delete;
+
+        ~BlockScope();
+
+        bool
+        active() const { return active_; }
+
+        void
+        setSignature(std::string sig) { signature_ = std::move(sig); }
+
+        void
+        add(ContractStats const& st) { stats_ += st; }
+
+        //
+        // Makes the kernel calls of the current thread count
+        // towards a BlockScope while the Worker exists, for
+        // blocks contracted on threads other than the one
+        // which created the scope (e.g. by OpenMP)
+        //
+        class Worker
+            {
+            BlockScope* prev_ = nullptr;
+            bool active_ = false;
+            public:
+
+            explicit
+            Worker(BlockScope & scope);
+
+            Worker(Worker const&) = delete;
+            Worker& operator=(Worker const&) = delete;
+
+            ~Worker();
+            };
+        };
+
+    };
+
+inline ContractProfiler&
+contractProfiler()
+    {
+    static ContractProfiler profiler_;
+    return profiler_;
+    }
+
+//Signature of a contraction C = A*B in the same
+//notation as makeBenchmark in tensorstats.h, e.g.
+//"C[bc]=A[ab]*B[ac] a:4 b:10 c:10"
+std::string
+contractSignature(Labels const& ai, std::vector<size_t> const& adims,
+                  Labels const& bi, std::vector<size_t> const& bdims,
+                  Labels const& ci, std::vector<size_t> const& cdims);
+
+//Flops per multiply-add for the given
+//element types (2 real, 4 mixed, 8 complex)
+template<typename VA, typename VB>
+double constexpr
+flopsPerMultAdd()
+    {
+    return (isCplx<VA>() && isCplx<VB>()) ? 8. : ((isCplx<VA>() || isCplx<VB>()) ? 4. : 2.);
+    }
+
+//Adds the elapsed time to *acc when destroyed (if acc != nullptr)
+class ProfileLap
+    {
+    double* acc_ = nullptr;
+    ContractProfiler::time_point start_;
+    public:
+
+    ProfileLap(bool on, double& acc)
+        {
+        if(on)
+            {
+            acc_ = &acc;
+            start_ = ContractProfiler::now();
+            }
+        }
+
+    ProfileLap(ProfileLap const&) = delete;
+    ProfileLap& operator=(ProfileLap const&) = delete;
+
+    ~ProfileLap() { if(acc_) *acc_ += ContractProfiler::since(start_); }
+    };
+
+} //namespace itensor
+
+#endif
@@ -23,6 +23,7 @@
 #include "itensor/types.h"
 #include "itensor/tensor/types.h"
 #include "itensor/util/error.h"
+#include "itensor/util/trace.h"
 #include "itensor/util/infarray.h"
 
 #if defined(_WIN32)
@@ -336,6 +337,7 @@ template<class T>
 void
 readFromFile(const std::string& fname, T& t) 
     { 
+    TRACE_SCOPE("io");
     std::ifstream s(fname.c_str(),std::ios::binary);
     if(!s.good()) 
         throw ITError("Couldn't open file \"" + fname + "\" for reading");
@@ -348,6 +350,7 @@ template<class T, typename... InitArgs>
 T
 readFromFile(const std::string& fname, InitArgs&&... iargs)
     { 
+    TRACE_SCOPE("io");
     std::ifstream s(fname.c_str(),std::ios::binary); 
     if(!s.good()) 
         throw ITError("Couldn't open file \"" + fname + "\" for reading");
@@ -362,6 +365,7 @@ template<class T>
 void
 writeToFile(const std::string& fname, const T& t) 
     { 
+    TRACE_SCOPE("io");
     std::ofstream s(fname.c_str(),std::ios::binary); 
     if(!s.good()) 
         throw ITError("Couldn't open file \"" + fname + "\" for writing");
@@ -21,6 +21,12 @@
 #include "itensor/util/stdx.h"
 #include "itensor/util/print.h"
 
+//
+// Compile-time numbered timers, enabled by defining COLLECT_TIMES.
+// For named, nested timings which can be switched on at runtime
+// see itensor/util/trace.h
+//
+
 //#define COLLECT_TIMES
 
 #ifdef COLLECT_TIMES
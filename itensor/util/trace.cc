@@ -0,0 +1,305 @@
+//
+// Copyright 2018 The Simons Foundation, Inc. - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "itensor/util/trace.h"
+#include "itensor/util/error.h"
+#include "itensor/util/print.h"
+
+using std::string;
+using std::vector;
+
+namespace itensor {
+
+namespace {
+
+struct TraceEvent
+    {
+    string path;
+    size_t nameoff = 0; //position of the scope name within path
+    double start = 0.; //microseconds since Tracer::origin()
+    double dur = 0.;   //microseconds
+    double self = 0.;  //dur minus time spent in child scopes
+    };
+
+struct TraceFrame
+    {
+    size_t pathlen = 0; //length of path before this frame was pushed
+    double child = 0.;
+    };
+
+struct ThreadTrace
+    {
+    int tid = 0;
+    string path;
+    vector<TraceFrame> stack;
+    vector<TraceEvent> events;
+    std::mutex mutex; //guards events
+    };
+
+struct TraceRegistry
+    {
+    std::mutex mutex;
+    vector<std::shared_ptr<ThreadTrace>> threads;
+    };
+
+TraceRegistry&
+registry()
+    {
+    static TraceRegistry reg_;
+    return reg_;
+    }
+
+ThreadTrace&
+threadTrace()
+    {
+    thread_local std::shared_ptr<ThreadTrace> tt_;
+    if(!tt_)
+        {
+        tt_ = std::make_shared<ThreadTrace>();
+        auto& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        tt_->tid = reg.threads.size();
+        reg.threads.push_back(tt_);
+        }
+    return *tt_;
+    }
+
+double
+microsec(Tracer::time_point t0, Tracer::time_point t1)
+    {
+    return std::chrono::duration<double,std::micro>(t1-t0).count();
+    }
+
+//Call f(ThreadTrace const&) for each thread, holding its lock
+template<typename F>
+void
+forEachThread(F&& f)
+    {
+    auto& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for(auto& tt : reg.threads)
+        {
+        std::lock_guard<std::mutex> tlock(tt->mutex);
+        f(*tt);
+        }
+    }
+
+struct TraceStat
+    {
+    size_t count = 0;
+    double total = 0.;
+    double self = 0.;
+    };
+
+std::map<string,TraceStat>
+statsByPath()
+    {
+    auto stats = std::map<string,TraceStat>{};
+    forEachThread([&stats](ThreadTrace const& tt)
+        {
+        for(auto& e : tt.events)
+            {
+            auto& st = stats[e.path];
+            st.count += 1;
+            st.total += e.dur;
+            st.self += e.self;
+            }
+        });
+    return stats;
+    }
+
+//Stats for a full path if recorded, otherwise
+//accumulated over all scopes with that name
+TraceStat
+findStat(string const& name)
+    {
+    auto stats = statsByPath();
+    auto it = stats.find(name);
+    if(it != stats.end()) return it->second;
+    auto res = TraceStat{};
+    for(auto& p : stats)
+        {
+        auto& path = p.first;
+        auto pos = path.rfind('/');
+        auto leaf = (pos == string::npos) ? path : path.substr(pos+1);
+        if(leaf != name) continue;
+        res.count += p.second.count;
+        res.total += p.second.total;
+        res.self += p.second.self;
+        }
+    return res;
+    }
+
+void
+writeJSONString(std::ostream& s, char const* str)
+    {
+    s << '"';
+    for(auto c = str; *c != '\0'; ++c)
+        {
+        if(*c == '"' || *c == '\\') s << '\\';
+        s << *c;
+        }
+    s << '"';
+    }
+
+} //namespace
+
+Tracer::
+Tracer()
+  : enabled_(false),
+    origin_(clock_type::now())
+    {
+    auto env = std::getenv("ITENSOR_TRACE");
+    if(env && string(env) != "0") enable(true);
+    }
+
+void Tracer::
+push(char const* name)
+    {
+    auto& tt = threadTrace();
+    tt.stack.push_back(TraceFrame{tt.path.size(),0.});
+    if(!tt.path.empty()) tt.path += '/';
+    tt.path += name;
+    }
+
+void Tracer::
+pop(time_point start)
+    {
+    auto end = clock_type::now();
+    auto& tt = threadTrace();
+    if(tt.stack.empty()) Error("Tracer::pop called with no open scope");
+
+    auto frame = tt.stack.back();
+    tt.stack.pop_back();
+
+    auto e = TraceEvent{};
+    e.start = microsec(origin_,start);
+    e.dur = microsec(start,end);
+    e.self = e.dur-frame.child;
+    e.path = tt.path;
+    e.nameoff = (frame.pathlen == 0) ? 0ul : frame.pathlen+1;
+    {
+    std::lock_guard<std::mutex> lock(tt.mutex);
+    tt.events.push_back(std::move(e));
+    }
+
+    tt.path.resize(frame.pathlen);
+    if(!tt.stack.empty()) tt.stack.back().child += microsec(start,end);
+    }
+
+void Tracer::
+reset()
+    {
+    auto& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for(auto& tt : reg.threads)
+        {
+        std::lock_guard<std::mutex> tlock(tt->mutex);
+        tt->events.clear();
+        }
+    origin_ = clock_type::now();
+    }
+
+size_t Tracer::
+numEvents() const
+    {
+    size_t n = 0;
+    forEachThread([&n](ThreadTrace const& tt) { n += tt.events.size(); });
+    return n;
+    }
+
+void Tracer::
+writeChromeTrace(std::ostream& s) const
+    {
+    s << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    forEachThread([&s,&first](ThreadTrace const& tt)
+        {
+        for(auto& e : tt.events)
+            {
+            if(!first) s << ",";
+            first = false;
+            s << "\n{\"name\":";
+            writeJSONString(s,e.path.c_str()+e.nameoff);
+            s << ",\"cat\":\"itensor\",\"ph\":\"X\"";
+            s << format(",\"ts\":%.3f,\"dur\":%.3f",e.start,e.dur);
+            s << ",\"pid\":0,\"tid\":" << tt.tid;
+            s << ",\"args\":{\"path\":";
+            writeJSONString(s,e.path.c_str());
+            s << "}}";
+            }
+        });
+    s << "\n]}\n";
+    }
+
+void Tracer::
+writeChromeTrace(string const& fname) const
+    {
+    std::ofstream s(fname.c_str());
+    if(!s.good()) throw ITError("Couldn't open file \"" + fname + "\" for writing");
+    writeChromeTrace(s);
+    }
+
+void Tracer::
+printSummary(std::ostream& s) const
+    {
+    auto stats = statsByPath();
+    //Percentages are relative to the time spent in top-level scopes
+    double toplevel = 0.;
+    size_t width = 4;
+    for(auto& p : stats)
+        {
+        if(p.first.find('/') == string::npos) toplevel += p.second.total;
+        width = std::max(width,p.first.size());
+        }
+    s << "-----------------------------------------------------\n";
+    s << format("%-*s %10s %12s %12s %12s %7s\n",width,"Scope","Calls",
+                "Total (s)","Self (s)","Avg (ms)","% Top");
+    for(auto& p : stats)
+        {
+        auto& st = p.second;
+        auto pct = toplevel > 0. ? 100.*st.total/toplevel : 0.;
+        s << format("%-*s %10d %12.4f %12.4f %12.4f %7.1f\n",width,p.first,st.count,
+                    1E-6*st.total,1E-6*st.self,1E-3*st.total/st.count,pct);
+        }
+    s << "-----------------------------------------------------";
+    }
+
+double Tracer::
+totalTime(string const& name) const
+    {
+    return 1E-6*findStat(name).total;
+    }
+
+size_t Tracer::
+count(string const& name) const
+    {
+    return findStat(name).count;
+    }
+
+std::ostream&
+operator<<(std::ostream& s, Tracer const& T)
+    {
+    T.printSummary(s);
+    return s;
+    }
+
+} //namespace itensor
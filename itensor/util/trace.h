@@ -0,0 +1,162 @@
+//
+// Copyright 2018 The Simons Foundation, Inc. - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef __ITENSOR_TRACE_H
+#define __ITENSOR_TRACE_H
+
+#include <atomic>
+#include <chrono>
+#include <iosfwd>
+#include <string>
+
+//
+// Runtime-switchable hierarchical tracer.
+//
+// Code is instrumented with named scopes:
+//
+//   TRACE_SCOPE("svd");
+//
+// which nest according to the call stack of each thread
+// (e.g. "dmrg/davidson/contract/gemm"). When tracing is
+// disabled (the default) a scope costs one relaxed atomic load.
+//
+// Tracing is turned on either by calling tracer().enable()
+// or by setting the environment variable ITENSOR_TRACE=1
+// before the program starts. Results can be written as a
+// Chrome trace (load in chrome://tracing or Perfetto) or
+// printed as a flat summary table:
+//
+//   tracer().writeChromeTrace("trace.json");
+//   println(tracer());
+//
+
+#define ITENSOR_TRACE_CAT_(A,B) A##B
+#define ITENSOR_TRACE_CAT(A,B) ITENSOR_TRACE_CAT_(A,B)
+
+#define TRACE_SCOPE(NAME) \
+    ::itensor::TraceScope ITENSOR_TRACE_CAT(trace_scope_instance_,__LINE__)(NAME);
+
+namespace itensor {
+
+class Tracer
+    {
+    std::atomic<bool> enabled_;
+    public:
+    using clock_type = std::chrono::steady_clock;
+    using time_point = clock_type::time_point;
+
+    Tracer();
+
+    bool
+    enabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+    void
+    enable(bool val = true) { enabled_.store(val,std::memory_order_relaxed); }
+
+    void
+    disable() { enable(false); }
+
+    //Discard all recorded events
+    void
+    reset();
+
+    //Total number of recorded (closed) scopes
+    size_t
+    numEvents() const;
+
+    //Write recorded events in the Chrome trace
+    //event format ("X" complete events)
+    void
+    writeChromeTrace(std::ostream& s) const;
+
+    void
+    writeChromeTrace(std::string const& fname) const;
+
+    //Print a table with one row per scope path,
+    //giving call count, total, self and average time
+    void
+    printSummary(std::ostream& s) const;
+
+    //Total time recorded for scopes with the given
+    //full path (e.g. "dmrg/davidson") or, if no such
+    //path exists, for all scopes with the given name
+    double
+    totalTime(std::string const& name) const;
+
+    //Number of calls recorded for the given path or name
+    size_t
+    count(std::string const& name) const;
+
+    //Used by TraceScope
+    void
+    push(char const* name);
+    void
+    pop(time_point start);
+
+    time_point
+    origin() const { return origin_; }
+
+    private:
+    time_point origin_;
+    };
+
+inline Tracer&
+tracer()
+    {
+    static Tracer tracer_;
+    return tracer_;
+    }
+
+std::ostream&
+operator<<(std::ostream& s, Tracer const& T);
+
+class TraceScope
+    {
+    Tracer::time_point start_;
+    bool active_ = false;
+    public:
+
+    explicit
+    TraceScope(char const* name)
+        {
+        auto& T = tracer();
+        if(T.enabled())
+            {
+            active_ = true;
+            T.push(name);
+            start_ = Tracer::clock_type::now();
+            }
+        }
+
+    TraceScope(TraceScope const&) = delete;
+    TraceScope& operator=(TraceScope const&) = delete;
+
+    //Close the scope before the end of the enclosing block
+    void
+    stop()
+        {
+        if(active_)
+            {
+            tracer().pop(start_);
+            active_ = false;
+            }
+        }
+
+    ~TraceScope() { stop(); }
+    };
+
+} //namespace itensor
+
+#endif
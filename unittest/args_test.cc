@@ -140,6 +140,48 @@ SECTION("Chop Spaces and Equals Signs")
     CHECK(args.getInt("MaxDim")==100);
     }
 
+SECTION("Keys")
+    {
+    auto key = Args::Key("MaxDim");
+    static_assert(Args::Key::hash("MaxDim",6) != 0,"Key hash not constexpr");
+    CHECK(key.hashValue() == Args::Key::hash("MaxDim",6));
+    CHECK(key.str() == "MaxDim");
+    CHECK(Args::Key("MaxDim").hashValue() != Args::Key("MinDim").hashValue());
+
+    Args args("MaxDim",10,"MinDim",2);
+    CHECK(args.getInt(key) == 10);
+    CHECK(args.getInt(Args::Key("MinDim")) == 2);
+    CHECK(args.getInt(std::string("MaxDim")) == 10);
+    CHECK(!args.defined(Args::Key("MaxDi")));
+
+    //A Key made from a std::string keeps its own copy
+    auto skey = Args::Key(std::string("Min")+"Dim");
+    CHECK(args.getInt(skey) == 2);
+    CHECK(skey.str() == "MinDim");
+    auto copy = skey;
+    CHECK(args.getInt(copy) == 2);
+    CHECK(!args.defined(std::string("MinDin")));
+
+    //Errors name the missing option
+    auto missing = std::string("NotAnOption");
+    try
+        {
+        args.getReal(missing);
+        CHECK(false);
+        }
+    catch(ITError const& e)
+        {
+        CHECK(std::string(e.what()).find("NotAnOption") != std::string::npos);
+        }
+
+    //Lookups fall through to the global Args
+    Args::global().add("TestGlobalKey",3);
+    CHECK(args.getInt("TestGlobalKey",0) == 3);
+    Args::global().remove("TestGlobalKey");
+    CHECK(args.getInt("TestGlobalKey",0) == 0);
+    CHECK_THROWS_AS(args.getInt("TestGlobalKey"),ITError);
+    }
+
 SECTION("Read/Write")
     {
     Args o1("Quiet",true,"Sz",1,"Pinning",-0.5,"Name","name");
@@ -3,6 +3,9 @@
 #include "itensor/mps/sites/electron.h"
 #include "itensor/mps/sites/fermion.h"
 #include "itensor/mps/sites/spinhalf.h"
+#include "itensor/mps/lattice/square.h"
+#include "itensor/mps/lattice/ordering.h"
+#include "itensor/mps/dmrg.h"
 #include "itensor/util/print_macro.h"
 
 #include "ExpIsing.h"
@@ -655,4 +658,77 @@ SECTION("Mixed Fermion and Non-Fermion Sites")
     CHECK_NOTHROW(H = toMPO(ampo));
     }
 
+SECTION("Site Ordering")
+    {
+    //Open chain with sites labelled n -> 5n mod 13
+    int N = 12;
+    auto label = [](int n) { return (5*n)%13; };
+    auto G = LatticeGraph{};
+    for(auto n : range1(N-1)) G.emplace_back(label(n),label(n+1));
+    CHECK(numSites(G) == N);
+    CHECK(cutWidth(G,SiteOrder(N)) > 2);
+
+    SECTION("Chain")
+        {
+        for(auto method : {"Best","CuthillMcKee","Fiedler"})
+            {
+            auto ord = siteOrder(G,{"Method=",method});
+            CHECK(cutWidth(G,ord) == 1);
+            auto Gn = relabel(G,ord);
+            for(auto& b : Gn) CHECK(std::abs(b.s1-b.s2) == 1);
+            }
+        }
+
+    SECTION("Square Lattice")
+        {
+        auto L = squareLattice(4,3,{"YPeriodic=",false});
+        auto ord = siteOrder(L);
+        CHECK(cutWidth(L,ord) <= cutWidth(L,SiteOrder(12)));
+        //Scrambling the labels does not hurt the result
+        auto scramble = SiteOrder(std::vector<int>{7,2,11,4,9,1,12,5,3,10,6,8});
+        auto Ls = relabel(L,scramble);
+        CHECK(cutWidth(Ls,SiteOrder(12)) > cutWidth(L,SiteOrder(12)));
+        CHECK(cutWidth(Ls,siteOrder(Ls)) <= cutWidth(L,SiteOrder(12)));
+        }
+
+    SECTION("Relabel AutoMPO")
+        {
+        N = 8;
+        auto sites = Fermion(N,{"ConserveQNs=",true});
+        auto ampo = AutoMPO(sites);
+        auto labels = std::vector<int>{5,2,8,3,7,1,6,4};
+        auto lab = [&labels](int n) { return labels[n-1]; };
+        for(auto n : range1(N-1))
+            {
+            ampo += -1.0,"Cdag",lab(n),"C",lab(n+1);
+            ampo += -1.0,"Cdag",lab(n+1),"C",lab(n);
+            ampo += 0.5,"N",lab(n),"N",lab(n+1);
+            ampo += 0.1*n,"N",lab(n);
+            }
+        auto ord = siteOrder(interactionGraph(ampo));
+        CHECK(cutWidth(interactionGraph(ampo),ord) == 1);
+        auto H = toMPO(ampo);
+        auto Hn = toMPO(relabel(ampo,ord));
+        CHECK(maxLinkDim(Hn) < maxLinkDim(H));
+
+        //Noise lets DMRG move particles between
+        //distant sites of the original ordering
+        auto sweeps = Sweeps(20);
+        sweeps.maxdim() = 10,20,40,64;
+        sweeps.cutoff() = 1E-12;
+        sweeps.noise() = 1E-4,1E-6,1E-8,0;
+        auto state = InitState(sites,"Emp");
+        for(auto n = 1; n <= N; n += 2) state.set(n,"Occ");
+        auto psi = randomMPS(state);
+        auto E = dmrg(psi,H,sweeps,{"Silent",true});
+        auto psin = randomMPS(state);
+        auto En = dmrg(psin,Hn,sweeps,{"Silent",true});
+        CHECK_CLOSE(E,En);
+
+        auto dens = expect(psi,sites,"N");
+        auto densn = toOriginalOrder(ord,expect(psin,sites,"N"));
+        for(auto n : range1(N)) CHECK(std::abs(dens[n-1]-densn[n-1]) < 1E-5);
+        }
+    }
+
 }
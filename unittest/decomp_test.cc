@@ -135,6 +135,52 @@ SECTION("Truncate Test")
         CHECK_CLOSE(truncerr,te_check);
         CHECK(truncerr < cutoff);
         }
+
+    SECTION("Case 5")
+        {
+        //Pre-parsed options give the same result
+        //as the positional interface
+        auto q = p;
+        cutoff = 1E-5;
+        auto opts = TruncateOptions(Args("Cutoff",cutoff,"MaxDim",maxdim,"DoRelCutoff",false));
+        CHECK(opts.truncate);
+        CHECK(opts.mindim == 1);
+        auto te = std::get<0>(truncate(q,opts));
+        tie(truncerr,docut_lower,docut_upper,ndegen) = truncate(p,maxdim,mindim,cutoff);
+        CHECK(q.size() == p.size());
+        CHECK_CLOSE(te,truncerr);
+        }
+    }
+
+SECTION("TruncateOptions")
+    {
+    auto opts = TruncateOptions(Args("MaxDim",10,"Cutoff",1E-8));
+    CHECK(opts.truncate);
+    CHECK(opts.maxdim == 10);
+    CHECK(opts.cutoff == 1E-8);
+    CHECK(opts.doRelCutoff);
+    CHECK(!opts.absoluteCutoff);
+
+    opts = TruncateOptions(Args("MaxDim",10,"Truncate",false));
+    CHECK(!opts.truncate);
+
+    auto none = TruncateOptions(Args("Quiet",true),diagTruncateDefaults());
+    CHECK(!none.truncate);
+    CHECK(none.cutoff == 0.);
+
+    //svd with parsed options matches svd with Args
+    auto i = Index(6,"i"),
+         j = Index(5,"j"),
+         k = Index(4,"k");
+    auto T = randomITensor(i,j,k);
+    auto args = Args("MaxDim",3,"Cutoff",1E-10);
+    auto U1 = ITensor(i,j), U2 = ITensor(i,j);
+    ITensor D1,V1,D2,V2;
+    auto spec1 = svd(T,U1,D1,V1,args);
+    auto spec2 = svd(T,U2,D2,V2,TruncateOptions(args,svdTruncateDefaults()));
+    CHECK(dim(commonIndex(U2,D2)) == 3);
+    CHECK_CLOSE(spec1.truncerr(),spec2.truncerr());
+    CHECK_CLOSE(norm(U1*D1*V1-U2*D2*V2),0.);
     }
 
 SECTION("ITensor SVD")
@@ -396,6 +442,24 @@ SECTION("QN ITensor SVD")
 
  SECTION("QN ITensor QR")
    {
+     SECTION("Block Order")
+       {
+       //Sorting the blocks of R by column permutes
+       //the blocks of the new index by a 3-cycle
+       auto i = Index(QN(0),2,QN(1),3,QN(2),1,QN(-1),2,Out,"i");
+       auto j = Index(QN(0),1,QN(1),2,QN(-1),2,Out,"j");
+       auto k = Index(QN(2),2,QN(0),2,QN(1),1,QN(-1),2,QN(3),1,In,"k");
+       auto T = randomITensor(QN(0),i,j,k);
+       auto [Q,R] = qr(T,{i,j});
+       auto q = commonIndex(Q,R);
+       CHECK(norm(T-Q*R) < 1E-12);
+       auto QQ = dag(prime(Q,q))*Q;
+       for(auto r : range1(dim(q)))
+       for(auto c : range1(dim(q)))
+           {
+           CHECK_CLOSE(elt(QQ,prime(q)=r,dag(q)=c),(r==c ? 1.0 : 0.0));
+           }
+       }
      SECTION("Zero Divergence")
        {
 	 Index u(QN(+2),3,
@@ -624,6 +688,47 @@ SECTION("QN ITensor denmatDecomp")
         }
     }
 
+SECTION("Partial Spectrum")
+    {
+    auto checkSame = [](ITensor const& AA, Args const& args)
+        {
+        ITensor A1,A2,B1,B2;
+        auto spec = denmatDecomp(AA,A1,A2,Fromleft,args);
+        auto pspec = denmatDecomp(AA,B1,B2,Fromleft,{args,"EigMethod=","syevr"});
+        CHECK(pspec.numEigsKept() == spec.numEigsKept());
+        CHECK_CLOSE(pspec.truncerr(),spec.truncerr());
+        for(auto n : range1(spec.numEigsKept()))
+            {
+            CHECK_CLOSE(pspec.eig(n),spec.eig(n));
+            }
+        CHECK(norm(A1*A2-B1*B2) < 1E-10*norm(AA));
+        };
+
+    SECTION("Dense")
+        {
+        auto l = Index(12,"l"),
+             s1 = Index(2,"s1"),
+             s2 = Index(2,"s2"),
+             r = Index(12,"r");
+        auto AA = randomITensor(l,s1,s2,r);
+        AA /= norm(AA);
+        checkSame(AA,{"MaxDim=",5});
+        checkSame(AA,{"MaxDim=",20,"Cutoff=",1E-2});
+        }
+
+    SECTION("QN")
+        {
+        auto S1 = Index(QN(+1),1,QN(-1),1),
+             S2 = Index(QN(+1),1,QN(-1),1);
+        auto L1 = Index(QN(+1),4,QN(0),8,QN(-1),4),
+             L3 = Index(QN(+1),4,QN(0),6,QN(-1),4);
+        auto AA = randomITensor(QN(),L1,S1,S2,dag(L3));
+        AA /= norm(AA);
+        checkSame(AA,{"MaxDim=",6});
+        checkSame(AA,{"MaxDim=",12,"Cutoff=",1E-3});
+        }
+    }
+
 SECTION("ITensor diagHermitian")
     {
     SECTION("Rank 2")
@@ -118,6 +118,25 @@ TEST_CASE("IndexTest")
         CHECK(hasTags(addTags(ic,"a,b"),"a,b,c"));
         }
 
+    SECTION("Fingerprint")
+        {
+        auto i = Index(3,"i");
+        auto j = Index(3,"i");
+
+        //Equal Indices have equal fingerprints
+        CHECK(i.fingerprint() == Index(i).fingerprint());
+        CHECK(i.fingerprint() == noPrime(prime(i,2)).fingerprint());
+        CHECK(i.fingerprint() == removeTags(addTags(i,"a"),"a").fingerprint());
+        CHECK(i.fingerprint() == dag(i).fingerprint());
+
+        //Changing the id, tags or prime level changes it
+        CHECK(i.fingerprint() != j.fingerprint());
+        CHECK(i.fingerprint() != sim(i).fingerprint());
+        CHECK(i.fingerprint() != prime(i).fingerprint());
+        CHECK(i.fingerprint() != addTags(i,"a").fingerprint());
+        CHECK(i.fingerprint() != replaceTags(i,"0","1").fingerprint());
+        }
+
     SECTION("Ignore spaces input string tests")
       {
       auto ts1 = TagSet("a,n=1");
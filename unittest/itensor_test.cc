@@ -5,7 +5,11 @@
 #include "itensor/util/iterate.h"
 #include "itensor/util/set_scoped.h"
 #include "itensor/util/print_macro.h"
+#include "itensor/util/contractprofiler.h"
+#include <array>
+#include <thread>
 #include <cstdlib>
+#include <sstream>
 
 using namespace std;
 using namespace itensor;
@@ -2192,6 +2196,23 @@ SECTION("Combiner")
                 }
             }
 
+         SECTION("Combine / Uncombine 5 - Permute three (QN)")
+            {
+            auto T = randomITensor(QN(),L1,L2,S1,S2);
+            auto B = randomITensor(QN(),L1,L2,S1,S2);
+            auto [C,ci] = combiner(S2,L1,S1);
+            auto R = T*C;
+
+            CHECK(order(R) == 2);
+            CHECK(hasIndex(R,ci));
+            CHECK_CLOSE(norm(T),norm(R));
+            //Combining both tensors leaves their overlap unchanged
+            CHECK_CLOSE(elt(R*dag(B*C)),elt(T*dag(B)));
+
+            R *= dag(C); //uncombine
+            CHECK_CLOSE(norm(R-T),0.);
+            }
+
         //Uncombine back:
         //auto TT = C * R;
 
@@ -2297,6 +2318,61 @@ for(auto j7 = 1; j7 <= b7.dim(); ++j7)
     }
 }
 
+SECTION("Large Element-wise Operations")
+{
+//Large enough that the element-wise kernels
+//split the work over threads
+auto x = Index(64,"x"),
+     y = Index(64,"y"),
+     z = Index(40,"z");
+auto positions = std::vector<std::array<int,3>>{{1,1,1},{64,64,40},{17,3,29},{40,60,1},{2,64,40}};
+
+auto A = randomITensor(x,y,z);
+auto AC = randomITensorC(x,y,z);
+
+Real nrm = 0;
+A.visit(CalcNrm(nrm));
+CHECK_CLOSE(std::sqrt(nrm),norm(A));
+nrm = 0;
+AC.visit(CalcNrm(nrm));
+CHECK_CLOSE(std::sqrt(nrm),norm(AC));
+
+auto f = Cplx(0.3,-1.7);
+auto fAC = f*AC;
+auto cAC = conj(AC);
+for(auto& p : positions)
+    {
+    auto v = eltC(AC,x=p[0],y=p[1],z=p[2]);
+    CHECK_CLOSE(eltC(fAC,x=p[0],y=p[1],z=p[2]),f*v);
+    CHECK_CLOSE(eltC(cAC,x=p[0],y=p[1],z=p[2]),std::conj(v));
+    }
+
+//Same and permuted index order, real and complex
+auto B = randomITensor(x,y,z);
+auto Bp = randomITensor(z,x,y);
+auto S = A;
+S += 2*B;
+auto Sp = A;
+Sp -= Bp;
+auto SC = AC;
+SC += B;
+for(auto& p : positions)
+    {
+    auto a = elt(A,x=p[0],y=p[1],z=p[2]);
+    CHECK_CLOSE(elt(S,x=p[0],y=p[1],z=p[2]),a+2*elt(B,x=p[0],y=p[1],z=p[2]));
+    CHECK_CLOSE(elt(Sp,x=p[0],y=p[1],z=p[2]),a-elt(Bp,x=p[0],y=p[1],z=p[2]));
+    CHECK_CLOSE(eltC(SC,x=p[0],y=p[1],z=p[2]),eltC(AC,x=p[0],y=p[1],z=p[2])+elt(B,x=p[0],y=p[1],z=p[2]));
+    }
+
+//Block sparse, permuted
+auto q = Index(QN(0),10,QN(1),10,QN(-1),10,"q");
+auto r = Index(QN(0),10,QN(1),10,QN(-1),10,"r");
+auto Q = randomITensor(QN(0),q,r,dag(prime(q)),dag(prime(r)));
+auto Qp = randomITensor(QN(0),dag(prime(r)),r,q,dag(prime(q)));
+CHECK(nnz(Q) > 131072);
+CHECK_CLOSE(norm(removeQNs(Q+Qp)-removeQNs(Q)-removeQNs(Qp)),0.);
+}
+
 SECTION("SumEls")
 {
 auto T = randomITensor(b2,b7);
@@ -2731,6 +2807,219 @@ SECTION("removeQNs")
       CHECK(elt(Aqn,ivs)==elt(A,ivs));
   }
 
+SECTION("QN Contraction (many blocks)")
+  {
+  //Indices with many small QN blocks
+  auto manyBlocks = [](std::string const& tags)
+    {
+    auto qns = Index::qnstorage{};
+    for(auto q : range(-6,7)) qns.emplace_back(QN(q),1+std::abs(q)%3);
+    return Index(std::move(qns),tags);
+    };
+  auto i = manyBlocks("i");
+  auto j = manyBlocks("j");
+  auto k = manyBlocks("k");
+  auto l = manyBlocks("l");
+
+  auto A = randomITensor(QN(0),i,j,dag(k));
+  auto B = randomITensor(QN(2),k,dag(j),l);
+
+  SECTION("QDense*QDense")
+    {
+    auto C = A*B;
+    CHECK(div(C) == QN(2));
+    CHECK(norm(C) > 0.);
+    CHECK_CLOSE(norm(removeQNs(C)-removeQNs(A)*removeQNs(B)),0.);
+    }
+
+  SECTION("QDense*QDiag")
+    {
+    auto D = delta(k,dag(prime(k)));
+    auto C = A*D;
+    CHECK(hasIndex(C,prime(k)));
+    CHECK_CLOSE(norm(removeQNs(C)-removeQNs(A)*removeQNs(D)),0.);
+    }
+  }
+
+SECTION("Contract Into")
+  {
+  SECTION("Dense")
+    {
+    auto i = Index(3,"i"),
+         j = Index(4,"j"),
+         k = Index(5,"k");
+    auto A = randomITensor(i,j);
+    auto B = randomITensor(j,k);
+    auto AB = A*B;
+
+    //Result index order is taken from C
+    auto C = randomITensor(k,i);
+    auto C0 = C;
+    C.store() = C0.store()->clone();
+    auto* p = C.store().get();
+    contract(A,B,C,2.,0.5);
+    CHECK(C.store().get() == p);
+    CHECK(C.inds()[0] == k);
+    CHECK_CLOSE(norm(C-(2.*AB+0.5*C0)),0.);
+
+    contract(A,B,C);
+    CHECK(C.store().get() == p);
+    CHECK_CLOSE(norm(C-AB),0.);
+
+    //Shared storage is not overwritten
+    auto D = C;
+    contract(A,B,C,1.,1.);
+    CHECK(C.store().get() != p);
+    CHECK_CLOSE(norm(D-AB),0.);
+    CHECK_CLOSE(norm(C-2.*AB),0.);
+
+    //C without the indices of the result
+    auto E = ITensor{};
+    contract(A,B,E);
+    CHECK_CLOSE(norm(E-AB),0.);
+    auto F = randomITensor(i,j);
+    contract(A,B,F);
+    CHECK(hasIndex(F,k));
+    CHECK_CLOSE(norm(F-AB),0.);
+
+    //Complex result into real storage
+    auto Z = randomITensorC(j,k);
+    auto G = randomITensor(i,k);
+    contract(A,Z,G);
+    CHECK_CLOSE(norm(G-A*Z),0.);
+    }
+
+  SECTION("Dense Interleaved Indices")
+    {
+    //Indices of C which come from A and B interleaved,
+    //so the result has to be permuted after the gemm
+    auto i = Index(3,"i"),
+         j = Index(4,"j"),
+         k = Index(5,"k"),
+         l = Index(2,"l"),
+         m = Index(3,"m");
+    auto A = randomITensor(i,j,l);
+    auto B = randomITensor(j,k);
+    auto AB = A*B;
+
+    auto C = randomITensor(i,k,l);
+    auto C0 = C;
+    C.store() = C0.store()->clone();
+    auto* p = C.store().get();
+    contract(A,B,C,2.,0.5);
+    CHECK(C.store().get() == p);
+    CHECK(C.inds()[1] == k);
+    CHECK_CLOSE(norm(C-(2.*AB+0.5*C0)),0.);
+
+    auto Bm = randomITensor(j,k,m);
+    auto ABm = A*Bm;
+    auto D = randomITensor(k,i,m,l);
+    auto D0 = D;
+    D.store() = D0.store()->clone();
+    p = D.store().get();
+    contract(A,Bm,D,2.,0.5);
+    CHECK(D.store().get() == p);
+    CHECK(D.inds()[0] == k);
+    CHECK_CLOSE(norm(D-(2.*ABm+0.5*D0)),0.);
+
+    auto Z = randomITensorC(j,k,m);
+    auto E = randomITensorC(k,i,m,l);
+    auto E0 = E;
+    E.store() = E0.store()->clone();
+    contract(A,Z,E,-1.,2.);
+    CHECK_CLOSE(norm(E-(2.*E0-A*Z)),0.);
+    }
+
+  SECTION("QDense")
+    {
+    auto i = Index(QN(-1),2,QN(0),3,QN(1),2,"i");
+    auto j = Index(QN(-1),2,QN(0),2,QN(1),3,"j");
+    auto k = Index(QN(-1),3,QN(0),1,QN(1),2,"k");
+    auto A = randomITensor(QN(0),i,dag(j));
+    auto B = randomITensor(QN(0),j,dag(k));
+    auto AB = A*B;
+
+    auto C = AB;
+    C.store() = AB.store()->clone();
+    auto* p = C.store().get();
+    contract(A,B,C,-1.,3.);
+    CHECK(C.store().get() == p);
+    CHECK_CLOSE(norm(C-2.*AB),0.);
+
+    //Index order differing from that of A*B
+    auto D = permute(AB,dag(k),i);
+    contract(A,B,D,1.,1.);
+    CHECK_CLOSE(norm(D-2.*AB),0.);
+    }
+  }
+
+SECTION("QN Block Lookup")
+  {
+  //Enough blocks that QDense builds its block lookup table
+  auto i = Index(QN(-2),1,QN(-1),2,QN(0),1,QN(1),2,QN(2),1,"i");
+  auto j = Index(QN(-2),2,QN(-1),1,QN(0),2,QN(1),1,QN(2),2,"j");
+  auto k = Index(QN(-2),1,QN(-1),1,QN(0),1,QN(1),1,QN(2),1,"k");
+
+  auto A = randomITensor(QN(0),i,j,dag(k));
+  CHECK(nnzblocks(A) >= 16);
+
+  SECTION("Get elements")
+    {
+    auto Ad = removeQNs(A);
+    for(auto const& ivs : iterInds(A))
+        CHECK(elt(A,ivs)==elt(Ad,ivs));
+    }
+
+  SECTION("Set elements")
+    {
+    //Blocks are inserted one element at a time
+    auto B = ITensor(i,j,dag(k));
+    for(auto const& ivs : iterInds(A))
+        {
+        auto val = elt(A,ivs);
+        if(val != 0.) B.set(ivs,val);
+        }
+    CHECK(nnzblocks(B) == nnzblocks(A));
+    CHECK(norm(B-A) == 0.);
+    }
+
+  SECTION("Add permuted")
+    {
+    auto B = randomITensor(QN(0),dag(k),j,i);
+    auto C = A+B;
+    CHECK_CLOSE(norm(removeQNs(C)-removeQNs(A)-removeQNs(B)),0.);
+    }
+
+  SECTION("Stale table")
+    {
+    //A table built for other offsets with the same number
+    //of blocks still gives the right positions
+    auto is = inds(A);
+    auto blocks = Blocks{};
+    for(auto bi : range(5))
+    for(auto bj : range(5))
+    for(auto bk : range(5))
+        {
+        blocks.push_back(Block{long(bi),long(bj),long(bk)});
+        }
+    std::sort(blocks.begin(),blocks.end());
+    auto offs1 = BlockOffsets{},
+         offs2 = BlockOffsets{};
+    for(auto n : range(20))
+        {
+        offs1.push_back(BlOf{blocks[n],long(n)});
+        offs2.push_back(BlOf{blocks[10+n],long(n)});
+        }
+    auto lookup = std::shared_ptr<const BlockLookup>{};
+    CHECK(findBlockLoc(lookup,is,offs1,offs1[3].block) == 3);
+    for(auto n : range(20))
+        {
+        CHECK(findBlockLoc(lookup,is,offs2,offs2[n].block) == long(n));
+        }
+    CHECK(findBlockLoc(lookup,is,offs2,offs1[3].block) == -1);
+    }
+  }
+
 SECTION("Block deficient ITensor tests")
   {
   auto i = Index(QN(0),2,QN(1),3,QN(2),4,QN(1),5,QN(3),6,"i");
@@ -2887,3 +3176,119 @@ SECTION("Test setting elements of QN ITensor")
 } //TEST_CASE("ITensor")
 
 
+
+TEST_CASE("ContractProfiler")
+{
+auto& P = contractProfiler();
+auto was_enabled = P.enabled();
+
+SECTION("Dense")
+    {
+    auto i = Index(4,"i");
+    auto j = Index(10,"j");
+    auto k = Index(6,"k");
+    auto A = randomITensor(i,j);
+    auto B = randomITensor(j,k);
+
+    P.disable();
+    P.reset();
+    auto C = A*B;
+    CHECK(P.entries().empty());
+
+    P.enable();
+    C = A*B;
+    C = A*B;
+    P.disable();
+    auto es = P.entries();
+    REQUIRE(es.size() == 1);
+    CHECK(es[0].source == "Dense");
+    CHECK(es[0].stats.calls == 2);
+    CHECK(es[0].stats.m*es[0].stats.n*es[0].stats.k == 4*10*6);
+    CHECK_CLOSE(es[0].stats.flops,2*2.*4*10*6);
+    CHECK_CLOSE(P.kernelTotal().flops,2*2.*4*10*6);
+
+    auto csv = std::ostringstream();
+    P.writeCSV(csv);
+    CHECK(csv.str().find("source,signature") == 0);
+    CHECK(csv.str().find(es[0].signature) != std::string::npos);
+    }
+
+SECTION("QDense")
+    {
+    auto s = Index(QN(+1),2,QN(-1),2,"s");
+    auto l = Index(QN(+1),3,QN(-1),3,"l");
+    auto A = randomITensor(QN(),s,l);
+    auto B = randomITensor(QN(),dag(s),prime(s));
+
+    P.enable();
+    P.reset();
+    auto C = A*B;
+    P.disable();
+    auto nqdense = 0;
+    auto blocks = size_t(0);
+    auto kernel_flops = 0.;
+    for(auto& e : P.entries())
+        {
+        if(e.source == "QDense") 
+            {
+            ++nqdense;
+            blocks = e.stats.blocks;
+            }
+        if(e.source == "QDenseBlock") kernel_flops += e.stats.flops;
+        }
+    CHECK(nqdense == 1);
+    CHECK(blocks > 0);
+    CHECK_CLOSE(P.kernelTotal().flops,kernel_flops);
+    }
+
+SECTION("QDense Blocks on Other Threads")
+    {
+    //With ITENSOR_USE_OMP the blocks below are contracted
+    //on several threads, all of which must count towards
+    //the QDense contraction
+    auto s = Index(QN(-2),4,QN(-1),4,QN(0),4,QN(1),4,QN(2),4,"s");
+    auto l = Index(QN(-2),6,QN(-1),6,QN(0),6,QN(1),6,QN(2),6,"l");
+    auto A = randomITensor(QN(),s,l,prime(l));
+    auto B = randomITensor(QN(),dag(s),prime(s));
+
+    P.enable();
+    P.reset();
+    auto C = A*B;
+    P.disable();
+    auto ndense = 0;
+    auto blocks = size_t(0);
+    for(auto& e : P.entries())
+        {
+        if(e.source == "Dense") ++ndense;
+        if(e.source == "QDense") blocks = e.stats.blocks;
+        }
+    CHECK(ndense == 0);
+    CHECK(blocks >= 5);
+
+    //Kernels run on a thread joining an existing scope
+    auto i = Index(4,"i");
+    auto j = Index(5,"j");
+    auto D = randomITensor(i,j);
+    P.enable();
+    P.reset();
+    {
+    ContractProfiler::BlockScope scope;
+    scope.setSignature("blocks");
+    std::thread([&]
+        {
+        ContractProfiler::BlockScope::Worker worker(scope);
+        auto E = D*prime(D,i);
+        }).join();
+    }
+    P.disable();
+    auto es = P.entries();
+    REQUIRE(es.size() == 2);
+    for(auto& e : es)
+        {
+        CHECK((e.source == "QDenseBlock" || (e.source == "QDense" && e.signature == "blocks")));
+        }
+    }
+
+P.reset();
+P.enable(was_enabled);
+}
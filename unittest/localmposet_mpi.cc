@@ -0,0 +1,138 @@
+//
+// Checks of LocalMPOSet_MPI (itensor/mps/localmposet_mpi.h).
+//
+// This program needs MPI, so it is not part of the Catch
+// test suite. It is run together with pdmrg_mpi by
+//
+//   make mpi
+//
+// The exit code is nonzero if any check fails.
+//
+#include "itensor/all.h"
+#include "itensor/mps/localmposet_mpi.h"
+
+using namespace itensor;
+
+int
+check(Environment const& env,
+      std::string const& name,
+      bool ok)
+    {
+    if(env.firstNode()) printfln("%s: %s",(ok ? "PASSED" : "FAILED"),name);
+    return ok ? 0 : 1;
+    }
+
+int
+main(int argc, char* argv[])
+    {
+    Environment env(argc,argv);
+
+    int N = 12;
+    int failed = 0;
+
+    //Index ids must agree on all nodes, so the sites,
+    //MPOs and initial state are made on node 0 and broadcast
+    auto sites = SpinHalf();
+    auto H = std::vector<MPO>(3);
+    auto psi0 = MPS();
+    if(env.firstNode())
+        {
+        sites = SpinHalf(N,{"ConserveQNs=",true});
+        auto ampo1 = AutoMPO(sites);
+        auto ampo2 = AutoMPO(sites);
+        auto ampo3 = AutoMPO(sites);
+        for(auto j : range1(N-1))
+            {
+            ampo1 += 0.5,"S+",j,"S-",j+1;
+            ampo2 += 0.5,"S-",j,"S+",j+1;
+            ampo3 +=     "Sz",j,"Sz",j+1;
+            }
+        H[0] = toMPO(ampo1);
+        H[1] = toMPO(ampo2);
+        H[2] = toMPO(ampo3);
+        auto state = InitState(sites);
+        for(auto j : range1(N)) state.set(j,(j%2==1 ? "Up" : "Dn"));
+        psi0 = randomMPS(state);
+        }
+    broadcast(env,sites,H[0],H[1],H[2],psi0);
+
+    //Distributed product agrees with the product on one node
+    {
+    auto b = N/2;
+    auto psi = psi0;
+    psi.position(b);
+    auto PHd = LocalMPOSet_MPI(env,H);
+    auto PHs = LocalMPOSet(H);
+    PHd.position(b,psi);
+    PHs.position(b,psi);
+    auto phi = psi(b)*psi(b+1);
+    ITensor phipd,
+            phips;
+    PHd.product(phi,phipd);
+    PHs.product(phi,phips);
+    failed += check(env,"product",norm(phipd-phips) < 1E-12*norm(phips));
+    failed += check(env,"expect",std::fabs(PHd.expect(phi)-PHs.expect(phi)) < 1E-12);
+    }
+
+    //Indices alike in tags, prime level and dimension are
+    //matched by id, also when the nodes store them in
+    //different orders (odd nodes reverse the order)
+    {
+    auto T = ITensor();
+    if(env.firstNode()) T = randomITensor(Index(2),Index(2),Index(3,"Link"));
+    broadcast(env,T);
+    auto is = inds(T);
+    auto Tn = T;
+    if(env.rank()%2 == 1) Tn = permute(T,is(3),is(2),is(1));
+    auto S = detail::allSumMatched(env,Tn);
+    failed += check(env,"sum with alike indices",norm(S-env.nnodes()*T) < 1E-12*norm(T));
+    }
+
+    //Site indices without their "n=" tags, so the two
+    //site indices of phi differ only by id
+    {
+    auto b = N/2;
+    auto psi = psi0;
+    psi.position(b);
+    auto Hu = H;
+    for(auto j : range1(N))
+        {
+        auto t = TagSet(format("n=%d",j));
+        psi.ref(j).removeTags(t);
+        for(auto& h : Hu) h.ref(j).removeTags(t);
+        }
+    auto PHd = LocalMPOSet_MPI(env,Hu);
+    auto PHs = LocalMPOSet(Hu);
+    PHd.position(b,psi);
+    PHs.position(b,psi);
+    auto phi = psi(b)*psi(b+1);
+    ITensor phipd,
+            phips;
+    PHd.product(phi,phipd);
+    PHs.product(phi,phips);
+    failed += check(env,"product with untagged sites",norm(phipd-phips) < 1E-12*norm(phips));
+    }
+
+    //DMRG with the distributed set gives the same energy
+    {
+    auto sweeps = Sweeps(5);
+    sweeps.maxdim() = 10,20,40;
+    sweeps.cutoff() = 1E-10;
+
+    auto psis = psi0;
+    auto Es = dmrg(psis,H,sweeps,{"Silent",true});
+
+    //davidson may randomize vectors, so use the
+    //same random numbers on every node
+    seedRNG(1);
+    auto psid = psi0;
+    auto PHd = LocalMPOSet_MPI(env,H);
+    auto Ed = DMRGWorker(psid,PHd,sweeps,{"Silent",true});
+
+    failed += check(env,"dmrg energy",std::fabs(Ed-Es) < 1E-8);
+    if(env.firstNode()) printfln("    nodes = %d, E = %.12f, serial E = %.12f",env.nnodes(),Ed,Es);
+    }
+
+    env.barrier();
+    return failed;
+    }
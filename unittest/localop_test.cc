@@ -273,6 +273,27 @@ SECTION("Test product")
     CHECK_CLOSE(norm(Hphi-noPrime(phi*Hpsi.L()*H(b)*H(b+1)*Hpsi.R())),0.);
     }
 
+  SECTION("Environments from both ends")
+    {
+    //Both the left and right environments
+    //are built by the first call to position
+    auto neel = InitState(sites);
+    for(auto j : range1(N)) neel.set(j,j%2==1 ? "Up" : "Dn");
+    auto phi0 = MPS(neel);
+    auto Hpsi = LocalMPO(H);
+    Hpsi.position(b,phi0);
+
+    auto L = ITensor(1.);
+    for(auto n : range1(b-1)) L *= phi0(n)*H(n)*dag(prime(phi0(n)));
+    auto R = ITensor(1.);
+    for(auto n = N; n > b+1; --n) R *= phi0(n)*H(n)*dag(prime(phi0(n)));
+    CHECK_CLOSE(norm(Hpsi.L()-L),0.);
+    CHECK_CLOSE(norm(Hpsi.R()-R),0.);
+
+    auto phi = phi0(b)*phi0(b+1);
+    CHECK_CLOSE(Hpsi.expect(phi),inner(phi0,H,phi0));
+    }
+
   }
 
 SECTION("LocalMPOSet")
@@ -351,6 +372,27 @@ SECTION("LocalMPOSet")
     CHECK_CLOSE(norm(Hphi-noPrime(phi*Hpsi.L()[0]*H[0](b)*H[0](b+1)*Hpsi.R()[0]+
                                   phi*Hpsi.L()[1]*H[1](b)*H[1](b+1)*Hpsi.R()[1])),0.);
     }
+
+  SECTION("Serial and concurrent terms agree")
+    {
+    auto Hpar = LocalMPOSet(H);
+    auto Hser = LocalMPOSet(H,{"ParallelTerms=",false});
+
+    psi.position(b);
+    Hpar.position(b,psi);
+    Hser.position(b,psi);
+
+    auto phi = psi(b)*psi(b+1);
+    ITensor phip_par,
+            phip_ser;
+    Hpar.product(phi,phip_par);
+    Hser.product(phi,phip_ser);
+    CHECK_CLOSE(norm(phip_par-phip_ser),0.);
+    CHECK_CLOSE(Hpar.expect(phi),Hser.expect(phi));
+
+    //Expectation value is the sum over the MPOs
+    CHECK_CLOSE(Hpar.expect(phi),elt(dag(phi)*phip_ser));
+    }
   }
 }
 
@@ -1,5 +1,6 @@
 #include "test.h"
 
+#include <thread>
 #include "itensor/util/autovector.h"
 #include "itensor/util/iterate.h"
 #include "itensor/tensor/algs.h"
@@ -1015,6 +1016,49 @@ SECTION("Test Matrix multiplication")
         }
     }
 
+SECTION("Single precision multiplication")
+    {
+    auto n = 64;
+    auto A = randomMat(n,n);
+    auto B = randomMat(n,n);
+    auto C = A*B;
+    auto Az = randomMatC(n,n);
+    auto Bz = randomMatC(n,n);
+    auto Cz = Az*Bz;
+
+    gemmSinglePrecision(true);
+    auto Cs = A*B;
+    auto Czs = Az*Bz;
+    auto Ct = transpose(B)*transpose(A);
+    gemmSinglePrecision(false);
+
+    auto diff = norm(Cs-C)/norm(C);
+    CHECK(diff > 1E-12);
+    CHECK(diff < 1E-5);
+    CHECK(norm(Czs-Cz)/norm(Cz) < 1E-5);
+    CHECK(norm(Ct-transpose(C))/norm(C) < 1E-5);
+
+    //Small products stay in double precision
+    gemmSinglePrecision(true);
+    auto a = randomMat(4,4);
+    auto b = randomMat(4,4);
+    auto ab = a*b;
+    gemmSinglePrecision(false);
+    CHECK(norm(ab-a*b) < 1E-14);
+
+    //The mode only applies to the thread setting it
+    {
+    auto scope = GemmPrecisionScope(true);
+    CHECK(gemmSinglePrecision());
+    auto Co = Matrix{};
+    auto other = true;
+    std::thread([&]{ other = gemmSinglePrecision(); Co = A*B; }).join();
+    CHECK(not other);
+    CHECK(norm(Co-C) < 1E-12*norm(C));
+    }
+    CHECK(not gemmSinglePrecision());
+    }
+
 
 SECTION("Addition / Subtraction")
     {
@@ -1437,6 +1481,48 @@ SECTION("diagHermitian")
 
         CHECK(norm(R-Mt) < 1E-12*norm(Mt));
         }
+
+    SECTION("Largest eigenpairs")
+        {
+        auto k = 3;
+        auto M = randomMat(N,N);
+        M = M+transpose(M);
+
+        Matrix U,Uk;
+        Vector d,dk;
+        diagHermitian(M,U,d);
+        diagHermitian(M,Uk,dk,k);
+
+        CHECK(ncols(Uk) == size_t(k));
+        CHECK(dk.size() == size_t(k));
+        for(auto j : range(k))
+            {
+            CHECK_CLOSE(dk(j),d(j));
+            auto u = column(Uk,j);
+            auto Mu = M*u;
+            for(auto r : range(N)) CHECK_CLOSE(Mu(r),dk(j)*u(r));
+            }
+        }
+
+    SECTION("Largest eigenpairs, complex case")
+        {
+        auto k = 4;
+        auto M = randomMatC(N,N);
+        M = M+conj(transpose(M));
+
+        CMatrix U,Uk;
+        Vector d,dk;
+        diagHermitian(M,U,d);
+        diagHermitian(M,Uk,dk,k);
+
+        for(auto j : range(k))
+            {
+            CHECK_CLOSE(dk(j),d(j));
+            auto u = column(Uk,j);
+            auto Mu = M*u;
+            for(auto r : range(N)) CHECK_CLOSE(Mu(r),dk(j)*u(r));
+            }
+        }
     }
 
  SECTION("QR")
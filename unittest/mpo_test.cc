@@ -7,6 +7,7 @@
 #include "itensor/mps/sites/electron.h"
 #include "itensor/mps/autompo.h"
 #include "itensor/mps/dmrg.h"
+#include "itensor/mps/dmrgscan.h"
 #include "mps_mpo_test_helper.h"
 
 using namespace itensor;
@@ -240,6 +241,41 @@ SECTION("applyMPO (DensityMatrix) with custom tags")
     CHECK_CLOSE(errorMPOProd(Hpsi,H,psi),0.0);
     }
 
+SECTION("applyMPO (ZipUp)")
+    {
+    auto method = "ZipUp";
+
+    auto N = 20;
+    auto sites = SpinHalf(N);
+    auto initstate = InitState(sites,"Up");
+    for( auto j : range1(N) ) if( j%2 == 1 )
+      initstate.set(j,"Dn");
+
+    auto psi = randomMPS(initstate,{"Complex=",true});
+
+    auto H = randomUnitaryMPO(sites);
+    auto K = randomUnitaryMPO(sites);
+
+    // Apply K to psi to entangle psi
+    psi = applyMPO(K,psi,{"Cutoff=",0.,"MaxDim=",200});
+    psi.noPrime("Site");
+
+    auto Hpsi = applyMPO(H,psi,{"Method=",method,"Cutoff=",1E-13,"MaxDim=",200});
+
+    CHECK(checkTags(Hpsi,"Site,1","Link,0"));
+    CHECK(orthoCenter(Hpsi) == 1);
+
+    CHECK_CLOSE(errorMPOProd(Hpsi,H,psi),0.0);
+
+    // Truncated, then improved by fitting
+    auto maxdim = maxLinkDim(psi);
+    auto Zpsi = applyMPO(H,psi,{"Method=",method,"Cutoff=",1E-13,"MaxDim=",maxdim});
+    CHECK(maxLinkDim(Zpsi) <= maxdim);
+    auto Fpsi = applyMPO(H,psi,{"Method=","Fit","Cutoff=",1E-13,"MaxDim=",maxdim,"Nsweep=",2});
+    CHECK(errorMPOProd(Zpsi,H,psi) < 1E-5);
+    CHECK(errorMPOProd(Fpsi,H,psi) < 1E-5);
+    }
+
 SECTION("applyMPO (Fit)")
     {
     auto method = "Fit";
@@ -513,6 +549,43 @@ SECTION("nmultMPO")
     }
   }
 
+SECTION("nmultMPO (Fit)")
+  {
+  auto N = 6;
+  auto sites = SpinHalf(N);
+  auto A = randomUnitaryMPO(sites);
+  auto B = randomUnitaryMPO(sites);
+
+  // Frobenius distance of MPOs with the same site indices
+  auto dist = [N](MPO const& X, MPO const& Y)
+    {
+    auto olap = [N](MPO const& P, MPO Q)
+      {
+      Q.replaceLinkInds(sim(linkInds(Q)));
+      auto L = ITensor(1.);
+      for(auto i : range1(N)) L = L*dag(P(i))*Q(i);
+      return real(eltC(L));
+      };
+    return std::sqrt(std::abs(olap(X,X)+olap(Y,Y)-2*olap(X,Y)));
+    };
+
+  auto C = nmultMPO(A,prime(B));
+  auto F = nmultMPO(A,prime(B),{"Method=","Fit","Nsweep=",2});
+
+  CHECK(checkTags(F,"Site,0","Site,2","Link,0"));
+  CHECK_CLOSE(traceC(F),traceC(C));
+  CHECK(dist(F,C) < 1E-5);
+
+  // Truncated: fitting does at least as well as zipping up
+  auto maxdim = maxLinkDim(C)/2;
+  auto Cz = nmultMPO(A,prime(B),{"MaxDim=",maxdim});
+  auto Cf = nmultMPO(A,prime(B),{"MaxDim=",maxdim,"Method=","Fit","Nsweep=",2});
+  CHECK(maxLinkDim(Cf) <= maxdim);
+  CHECK(dist(Cf,C) <= dist(Cz,C)+1E-5);
+
+  CHECK_THROWS_AS(nmultMPO(A,prime(B),{"Method=","Wrong"}),ITError);
+  }
+
 SECTION("nmultMPO (custom tags)")
   {
   auto N = 4;
@@ -569,6 +642,36 @@ SECTION("DMRG")
   CHECK_CLOSE((energy-energy_exact)/energy_exact,0.);
   }
 
+SECTION("DMRG with single precision sweeps")
+  {
+  int N = 32;
+  auto sites = SpinHalf(N,{"ConserveQNs=",false});
+  auto psi0 = randomMPS(InitState(sites,"Up"));
+
+  auto h = 0.5;
+
+  auto ampo = AutoMPO(sites);
+  for(int j = 1; j < N; ++j)
+      {
+      ampo += -1.0,"Sx",j,"Sx",j+1;
+      ampo += -h,"Sz",j;
+      }
+  ampo += -h,"Sz",N;    
+  auto H = toMPO(ampo);
+
+  auto sweeps = Sweeps(7);
+  sweeps.maxdim() = 10,20,30;
+  sweeps.cutoff() = 1E-12;
+  auto [Energy,psi] = dmrg(H,psi0,sweeps,{"Silent",true,"SinglePrecisionSweeps",4});
+  auto energy = Energy/N;
+  (void)psi;
+  CHECK(not gemmSinglePrecision());
+
+  auto Energy_exact = 1.0 - 1.0/sin(Pi/(2*(2*N+1)));
+  auto energy_exact = Energy_exact/(4*N);
+  CHECK_CLOSE((energy-energy_exact)/energy_exact,0.);
+  }
+
 SECTION("DMRG with QNs")
   {
   int N = 32;
@@ -601,4 +704,107 @@ SECTION("DMRG with QNs")
   CHECK_CLOSE((energy-energy_exact)/energy_exact,0.);
   }
 
+SECTION("innerMatrix with MPO")
+    {
+    auto N = 10;
+    auto sites = SpinHalf(N,{"ConserveQNs=",false});
+    auto H = randomUnitaryMPO(sites);
+    auto psis = std::vector<MPS>{};
+    for(int n = 0; n < 4; ++n) psis.push_back(randomMPS(sites,3,{"Complex=",true}));
+
+    auto G = innerMatrix(psis,H);
+    CHECK_EQUAL(nrows(G),4);
+    CHECK_EQUAL(ncols(G),4);
+    for(auto i : range(4))
+    for(auto j : range(4))
+        {
+        CHECK_CLOSE(G(i,j),innerC(psis[i],H,psis[j]));
+        }
+
+    //States with other copies of the site indices
+    auto psisim = psis;
+    for(auto j : range(4))
+        {
+        if(j%2 == 0) psisim[j].replaceSiteInds(sim(siteInds(psis[j])));
+        }
+    auto Gs = innerMatrix(psisim,H);
+    for(auto i : range(4))
+    for(auto j : range(4))
+        {
+        CHECK_CLOSE(Gs(i,j),G(i,j));
+        }
+    }
+
+}
+
+TEST_CASE("DMRGScan")
+{
+auto N = 8;
+auto sites = SpinHalf(N,{"ConserveQNs=",true});
+auto state = InitState(sites);
+for(auto j : range1(N)) state.set(j,j%2==1 ? "Up" : "Dn");
+auto psi0 = MPS(state);
+
+auto sweeps = Sweeps(5);
+sweeps.maxdim() = 10,20,40;
+sweeps.cutoff() = 1E-12;
+auto warm_sweeps = Sweeps(2);
+warm_sweeps.maxdim() = 40;
+warm_sweeps.cutoff() = 1E-12;
+
+//J1-J2 chain for several J2
+auto J2s = std::vector<Real>{0.,0.1,0.2,0.3};
+auto jobs = std::vector<DMRGJob>{};
+for(auto J2 : J2s)
+    {
+    auto ampo = AutoMPO(sites);
+    for(auto j : range1(N-1))
+        {
+        ampo += 0.5,"S+",j,"S-",j+1;
+        ampo += 0.5,"S-",j,"S+",j+1;
+        ampo +=     "Sz",j,"Sz",j+1;
+        }
+    for(auto j : range1(N-2))
+        {
+        ampo += 0.5*J2,"S+",j,"S-",j+2;
+        ampo += 0.5*J2,"S-",j,"S+",j+2;
+        ampo +=     J2,"Sz",j,"Sz",j+2;
+        }
+    jobs.emplace_back(ampo,psi0,sweeps,std::vector<Real>{J2});
+    jobs.back().warm_sweeps = warm_sweeps;
+    }
+
+auto E = std::vector<Real>{};
+for(auto& job : jobs)
+    {
+    auto [energy,psi] = dmrg(toMPO(job.ampo),psi0,sweeps,{"Silent=",true});
+    E.push_back(energy);
+    }
+
+SECTION("Concurrent")
+    {
+    auto res = dmrgScan(jobs,{"NumThreads=",2});
+    for(auto n : range(jobs))
+        {
+        CHECK(res[n].warm_start == -1);
+        CHECK_CLOSE(res[n].energy,E[n]);
+        }
+    }
+
+SECTION("Warm start")
+    {
+    //MPO given instead of AutoMPO for the last job
+    jobs.back().H = toMPO(jobs.back().ampo);
+    auto res = dmrgScan(jobs,{"NumThreads=",1,"WarmStart=",true});
+    CHECK(res[0].warm_start == -1);
+    for(auto n : range1(jobs.size()-1))
+        {
+        CHECK(res[n].warm_start == int(n)-1);
+        }
+    for(auto n : range(jobs))
+        {
+        CHECK_CLOSE(res[n].energy,E[n]);
+        CHECK_CLOSE(inner(res[n].psi,toMPO(jobs[n].ampo),res[n].psi),res[n].energy);
+        }
+    }
 }
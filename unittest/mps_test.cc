@@ -9,6 +9,7 @@
 #include "itensor/util/iterate.h"
 #include "mps_mpo_test_helper.h"
 #include <iomanip>
+#include <map>
 
 using namespace itensor;
 using std::vector;
@@ -259,6 +260,140 @@ SECTION("MPSAddition 2")
     CHECK_EQUAL(order(psi(10)),2);
     }
 
+SECTION("MPSAddition Many")
+    {
+    auto Nt = 5;
+    auto exactNorm = [](std::vector<MPS> const& terms)
+        {
+        auto z = Cplx(0.);
+        for(auto& a : terms)
+        for(auto& b : terms) z += innerC(a,b);
+        return z;
+        };
+    auto checkSum = [&exactNorm](std::vector<MPS> const& terms, Args const& args)
+        {
+        auto psi = sum(terms,args);
+        CHECK(checkTags(psi));
+        auto exact = exactNorm(terms);
+        CHECK_CLOSE(innerC(psi,psi)/exact,1.);
+        for(auto& t : terms) 
+            {
+            auto sum_t = Cplx(0.);
+            for(auto& a : terms) sum_t += innerC(t,a);
+            CHECK_CLOSE(innerC(t,psi)/sum_t,1.);
+            }
+        };
+
+    SECTION("No QNs")
+        {
+        auto terms = std::vector<MPS>{};
+        for(auto n : range(Nt)) 
+            {
+            terms.push_back(randomMPS(shsites,2));
+            terms.back().ref(1) *= std::exp(Complex_i*n);
+            }
+        checkSum(terms,{"Cutoff=",1E-12});
+        checkSum(terms,{"Cutoff=",1E-12,"MaxSumDim=",4});
+        checkSum(terms,{"Cutoff=",1E-12,"Method=","Fit","Nsweep=",2});
+        checkSum(terms,{"Cutoff=",1E-12,"Method=","Pairwise"});
+        CHECK_THROWS_AS(sum(terms,Args("Method=","NotAMethod")),ITError);
+        }
+
+    SECTION("QNs")
+        {
+        auto terms = std::vector<MPS>{};
+        for(auto n = 0; n < Nt; ++n) terms.push_back(randomMPS(shNeelQNs));
+        checkSum(terms,{"Cutoff=",1E-12});
+        checkSum(terms,{"Cutoff=",1E-12,"MaxSumDim=",4});
+        checkSum(terms,{"Cutoff=",1E-12,"Method=","Fit"});
+        auto psi = sum(terms);
+        CHECK_EQUAL(totalQN(psi),totalQN(terms.front()));
+        }
+    }
+
+SECTION("innerMatrix")
+    {
+    auto psis = std::vector<MPS>{};
+    for(int n = 0; n < 4; ++n) psis.push_back(randomMPS(shsites,3,{"Complex=",true}));
+    psis.push_back(MPS(shNeel));
+
+    auto G = innerMatrix(psis);
+    CHECK_EQUAL(nrows(G),5);
+    CHECK_EQUAL(ncols(G),5);
+    for(auto i : range(5))
+    for(auto j : range(5))
+        {
+        CHECK_CLOSE(G(i,j),innerC(psis[i],psis[j]));
+        }
+
+    SECTION("QNs")
+        {
+        auto qpsis = std::vector<MPS>{};
+        for(int n = 0; n < 3; ++n) qpsis.push_back(randomMPS(shNeelQNs));
+        auto Gq = innerMatrix(qpsis);
+        for(auto i : range(3))
+        for(auto j : range(3))
+            {
+            CHECK_CLOSE(Gq(i,j),innerC(qpsis[i],qpsis[j]));
+            }
+        }
+    }
+
+SECTION("sample")
+    {
+    //Compare the sampled frequencies with |<s|psi>|^2
+    auto checkSampling = [](MPS const& psi)
+        {
+        auto N = length(psi);
+        auto nsample = 20000;
+        auto configs = sample(psi,nsample,{"Seed=",17});
+        CHECK(configs.size() == size_t(nsample));
+        //Same seed, same samples
+        auto same = (configs == sample(psi,nsample,{"Seed=",17}));
+        CHECK(same);
+
+        auto T = psi(1);
+        for(auto j : range1(2,N)) T *= psi(j);
+        auto nrm2 = std::norm(norm(T));
+        auto counts = std::map<std::vector<int>,int>{};
+        for(auto& c : configs) counts[c] += 1;
+        for(auto& c : counts)
+            {
+            auto ivs = std::vector<IndexVal>{};
+            for(auto j : range1(N)) ivs.push_back(siteIndex(psi,j)=c.first[j-1]);
+            auto p = std::norm(eltC(T,ivs))/nrm2;
+            CHECK(std::abs(Real(c.second)/nsample-p) < 0.015);
+            }
+        };
+
+    auto N = 4;
+    auto sites = SpinHalf(N,{"ConserveQNs=",false});
+    checkSampling(randomMPS(sites,3,{"Complex=",true}));
+
+    auto qsites = SpinHalf(N,{"ConserveQNs=",true});
+    auto state = InitState(qsites);
+    for(auto j : range1(N)) state.set(j,j%2==1 ? "Up" : "Dn");
+    auto psi = sum(std::vector<MPS>{randomMPS(state),randomMPS(state),randomMPS(state)});
+    checkSampling(psi);
+    for(auto& c : sample(psi,1000)) 
+        {
+        //Sampled configurations conserve total Sz
+        auto nup = 0;
+        for(auto v : c) nup += (v == 1);
+        CHECK_EQUAL(nup,N/2);
+        }
+
+    //A uniform number close to 1 can put u at or past the
+    //sum of the probabilities, which must not pick a
+    //state of zero probability
+    auto prob = std::vector<Real>{0.1,0.2,0.,0.};
+    auto total = prob[0]+prob[1];
+    CHECK_EQUAL(detail::drawState(prob,std::nextafter(1.,0.)*total),1);
+    CHECK_EQUAL(detail::drawState(prob,total),1);
+    CHECK_EQUAL(detail::drawState(prob,0.),0);
+    CHECK_EQUAL(detail::drawState(prob,0.15),1);
+    }
+
 SECTION("PositionTest")
     {
     auto sites = Fermion(10);
@@ -281,6 +416,87 @@ SECTION("PositionTest")
     CHECK_EQUAL(findCenter(psi),4);
     }
 
+SECTION("Position without truncation")
+    {
+    SECTION("No QNs")
+        {
+        auto psi = randomMPS(shsites,4);
+        psi.position(1);
+        auto opsi = psi;
+        opsi.position(N);
+        CHECK(checkOrtho(opsi));
+        CHECK(orthoCenter(opsi) == N);
+        CHECK_CLOSE(innerC(opsi,psi),1.0);
+        CHECK(checkTags(opsi));
+
+        auto spsi = psi;
+        spsi.position(N,{"UseSVD=",true});
+        for(auto b : range1(N-1))
+            {
+            CHECK(dim(linkIndex(opsi,b)) == dim(linkIndex(spsi,b)));
+            }
+        }
+
+    SECTION("QNs")
+        {
+        auto psi = sum(randomMPS(shNeelQNs),randomMPS(shNeelQNs));
+        psi.position(N);
+        auto opsi = psi;
+        opsi.position(1);
+        CHECK(checkOrtho(opsi));
+        CHECK(findCenter(opsi) == 1);
+        CHECK_CLOSE(innerC(opsi,psi),innerC(psi,psi));
+        CHECK(checkTags(opsi));
+        CHECK(checkQNs(opsi));
+        opsi.position(N/2);
+        CHECK(checkOrtho(opsi));
+        CHECK(findCenter(opsi) == N/2);
+        }
+
+    SECTION("QNs with wide blocks")
+        {
+        //The links of a direct sum are larger than needed, so
+        //QN blocks have more columns than rows and the gauge is
+        //moved by SVD; after that the blocks are tall and QR
+        //is used
+        auto ampo = AutoMPO(shsitesQNs);
+        for(auto j : range1(N-1))
+            {
+            ampo += 0.5,"S+",j,"S-",j+1;
+            ampo += 0.5,"S-",j,"S+",j+1;
+            ampo +=     "Sz",j,"Sz",j+1;
+            }
+        auto H = toMPO(ampo);
+        auto psi = directSum(std::vector<MPS>{randomMPS(shNeelQNs),randomMPS(shNeelQNs),randomMPS(shNeelQNs)});
+        auto nrm2 = innerC(psi,psi).real();
+        auto E = innerC(psi,H,psi).real();
+        psi.position(1);
+        CHECK(checkOrtho(psi));
+        CHECK(findCenter(psi) == 1);
+        CHECK(checkQNs(psi));
+        CHECK_CLOSE(innerC(psi,psi).real(),nrm2);
+        CHECK_CLOSE(innerC(psi,H,psi).real(),E);
+        psi.position(N);
+        CHECK(checkOrtho(psi));
+        CHECK(findCenter(psi) == N);
+        CHECK(checkQNs(psi));
+        CHECK_CLOSE(innerC(psi,psi).real(),nrm2);
+        CHECK_CLOSE(innerC(psi,H,psi).real(),E);
+        }
+
+    SECTION("Orthogonalize")
+        {
+        auto psi = MPS(shsites,3);
+        for(auto n : range1(N)) psi.ref(n).randomize();
+        auto opsi = psi;
+        opsi.orthogonalize({"Truncate=",false});
+        CHECK(checkOrtho(opsi));
+        CHECK_CLOSE(inner(opsi,psi),inner(psi,psi));
+        CHECK(maxLinkDim(opsi) == 3);
+        CHECK(checkTags(opsi));
+        }
+    }
+
 SECTION("Orthogonalize")
     {
     auto d = 20;
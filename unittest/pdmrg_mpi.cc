@@ -0,0 +1,115 @@
+//
+// Checks of the real-space parallel DMRG (itensor/mps/pdmrg.h).
+//
+// This program needs MPI, so it is not part of the Catch
+// test suite. Build and run it on a single machine using
+//
+//   make mpi
+//
+// which launches it with 1, 2 and 3 MPI processes.
+// The exit code is nonzero if any check fails.
+//
+#include "itensor/all.h"
+#include "itensor/mps/pdmrg.h"
+
+using namespace itensor;
+
+int
+check(Environment const& env,
+      std::string const& name,
+      bool ok)
+    {
+    if(env.firstNode()) printfln("%s: %s",(ok ? "PASSED" : "FAILED"),name);
+    return ok ? 0 : 1;
+    }
+
+int
+runChecks(Environment const& env,
+          SiteSet const& sites,
+          MPO const& H,
+          Real Eexact,
+          std::string const& name)
+    {
+    auto N = length(sites);
+
+    auto sweeps = Sweeps(20);
+    sweeps.maxdim() = 10,20,40,60;
+    sweeps.cutoff() = 1E-11;
+    sweeps.niter() = 2;
+
+    auto state = InitState(sites);
+    for(auto j : range1(N)) state.set(j,(j%2==1 ? "Up" : "Dn"));
+    auto psi = MPS(state);
+
+    auto E = pdmrg(psi,H,sweeps,env,{"Quiet",true,"Silent",true});
+
+    int failed = 0;
+    failed += check(env,name+" energy",std::fabs(E-Eexact) < 1E-6);
+
+    //Every node holds the gathered, normalized MPS
+    auto nrm = norm(psi);
+    auto EH = innerC(psi,H,psi).real();
+    failed += check(env,name+" norm of gathered MPS",std::fabs(nrm-1.) < 1E-10);
+    failed += check(env,name+" <psi|H|psi>",std::fabs(EH-Eexact) < 1E-6);
+    if(env.firstNode())
+        {
+        printfln("    nodes = %d, E = %.12f, <psi|H|psi> = %.12f, serial E = %.12f",
+                 env.nnodes(),E,EH,Eexact);
+        }
+    return failed;
+    }
+
+int
+main(int argc, char* argv[])
+    {
+    Environment env(argc,argv);
+
+    int N = 20;
+    int failed = 0;
+
+    for(auto conserve : {true,false})
+        {
+        //Index ids must agree on all nodes, so the
+        //sites and MPO are made on node 0 and broadcast
+        auto sites = SpinHalf();
+        auto H = MPO();
+        if(env.firstNode())
+            {
+            sites = SpinHalf(N,{"ConserveQNs=",conserve});
+            auto ampo = AutoMPO(sites);
+            for(auto j : range1(N-1))
+                {
+                ampo += 0.5,"S+",j,"S-",j+1;
+                ampo += 0.5,"S-",j,"S+",j+1;
+                ampo +=     "Sz",j,"Sz",j+1;
+                }
+            H = toMPO(ampo);
+            }
+        broadcast(env,sites,H);
+
+        //Serial reference energy, computed on node 0
+        Real Eexact = 0.;
+        if(env.firstNode())
+            {
+            auto sweeps = Sweeps(10);
+            sweeps.maxdim() = 10,20,40,60;
+            sweeps.cutoff() = 1E-11;
+            auto state = InitState(sites);
+            for(auto j : range1(N)) state.set(j,(j%2==1 ? "Up" : "Dn"));
+            auto psi0 = MPS(state);
+            Eexact = dmrg(psi0,H,sweeps,{"Silent",true});
+            }
+        broadcast(env,Eexact);
+
+        failed += runChecks(env,sites,H,Eexact,(conserve ? "QN" : "dense"));
+        }
+
+    auto blocks = parallelBlocks(11,3);
+    failed += check(env,"parallelBlocks",
+                    blocks[0] == std::make_pair(1,4)
+                    && blocks[1] == std::make_pair(5,8)
+                    && blocks[2] == std::make_pair(9,11));
+
+    env.barrier();
+    return failed;
+    }
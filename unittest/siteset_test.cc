@@ -146,6 +146,41 @@ SECTION("Fermion")
     op(sites,"F",2); 
     }
 
+SECTION("Operator Cache")
+    {
+    auto sites = Electron(N,{"ConserveQNs=",true});
+
+    auto Cup = op(sites,"Cup",3);
+    CHECK(norm(op(sites,"Cup",3)-Cup) < 1E-12);
+
+    //Modifying a returned operator leaves later ones unchanged
+    auto A = op(sites,"Nup",3);
+    A.set(2,2,10.);
+    CHECK(norm(op(sites,"Nup",3)-A) > 1);
+    CHECK(elt(op(sites,"Nup",3),2,2) == Approx(1.));
+
+    //Composite operators
+    auto CC = op(sites,"Cup*Cdn",3);
+    CHECK(norm(CC-multSiteOps(op(sites,"Cup",3),op(sites,"Cdn",3))) < 1E-12);
+    CHECK(norm(op(sites,"Cup*Cdn",3)-CC) < 1E-12);
+
+    //Different sites and args give different operators
+    CHECK(hasIndex(op(sites,"Cup",4),sites(4)));
+    auto P2 = op(sites,"Proj",3,{"State=",2});
+    auto P3 = op(sites,"Proj",3,{"State=",3});
+    CHECK(elt(P2,2,2) == Approx(1.));
+    CHECK(elt(P3,3,3) == Approx(1.));
+    CHECK(elt(P3,2,2) == Approx(0.));
+
+    //Copies of a SiteSet share the cache, and
+    //replacing a site clears it
+    auto sites2 = sites;
+    auto s3 = Index(QN({"Nf",0,-1}),1,QN({"Nf",1,-1}),1,"Site,n=3");
+    sites2.set(3,GenericSite(s3));
+    CHECK(sites(3) == s3);
+    CHECK(hasIndex(op(sites,"Id",3),s3));
+    }
+
 SECTION("tJ")
     {
     auto sites = tJ(N,{"ConserveQNs=",true});
@@ -319,6 +319,31 @@ SECTION("Slicing")
                 }
             }
 
+        SECTION("High Order")
+            {
+            //Order above the largest specialized loop nest,
+            //with no extent-1 indices or neighboring indices
+            //kept in order, so no indices can be fused
+            auto T10 = Tensor(2,3,2,2,3,2,2,2,3,2);
+            for(auto& el : T10) el = detail::quickran();
+            auto P = Labels{9,8,7,6,5,4,3,2,1,0};
+            auto PT = Tensor(permute(T10,P));
+            auto j = Labels(10,0);
+            for(auto& i : PT.range())
+                {
+                for(auto n : range(10)) j[n] = i[P[n]];
+                CHECK_CLOSE(PT(i), T10(j));
+                }
+
+            P = Labels{2,0,4,1,6,3,8,5,9,7};
+            PT = Tensor(permute(T10,P));
+            for(auto& i : PT.range())
+                {
+                for(auto n : range(10)) j[n] = i[P[n]];
+                CHECK_CLOSE(PT(i), T10(j));
+                }
+            }
+
         }
 
     SECTION("Sub Tensor")
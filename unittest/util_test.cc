@@ -3,6 +3,8 @@
 #include "itensor/global.h"
 #include "itensor/util/infarray.h"
 #include "itensor/util/stats.h"
+#include "itensor/util/trace.h"
+#include <sstream>
 
 using namespace itensor;
 using namespace std;
@@ -261,3 +263,68 @@ SECTION("BinErr")
     }
 }
 
+
+TEST_CASE("Tracer")
+{
+auto& T = tracer();
+auto was_enabled = T.enabled();
+
+SECTION("Disabled")
+    {
+    T.disable();
+    T.reset();
+        {
+        TRACE_SCOPE("outer");
+        }
+    CHECK(T.numEvents() == 0);
+    }
+
+SECTION("Nested Scopes")
+    {
+    T.enable();
+    T.reset();
+    for(int n = 0; n < 3; ++n)
+        {
+        TRACE_SCOPE("outer");
+            {
+            TRACE_SCOPE("inner");
+            }
+            {
+            TRACE_SCOPE("inner");
+            }
+        }
+    T.disable();
+    CHECK(T.numEvents() == 9);
+    CHECK(T.count("outer") == 3);
+    CHECK(T.count("outer/inner") == 6);
+    CHECK(T.count("inner") == 6);
+    CHECK(T.totalTime("outer") >= T.totalTime("outer/inner"));
+
+    auto trace = std::ostringstream();
+    T.writeChromeTrace(trace);
+    auto json = trace.str();
+    CHECK(json.find("\"traceEvents\"") != std::string::npos);
+    CHECK(json.find("\"path\":\"outer/inner\"") != std::string::npos);
+
+    auto summary = std::ostringstream();
+    summary << T;
+    CHECK(summary.str().find("outer/inner") != std::string::npos);
+    }
+
+SECTION("Stop")
+    {
+    T.enable();
+    T.reset();
+        {
+        auto scope = TraceScope("stopped");
+        scope.stop();
+        TRACE_SCOPE("after");
+        }
+    T.disable();
+    CHECK(T.count("stopped") == 1);
+    CHECK(T.count("after") == 1);
+    }
+
+T.reset();
+T.enable(was_enabled);
+}